@@ -0,0 +1,156 @@
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "bench_perf.h"
+
+#include <stdio.h>
+#include <string.h>
+
+static const char *s_counter_names[BENCH_PERF_NUM_COUNTERS] = {
+    "cycles",
+    "instructions",
+    "branch_misses",
+    "l1d_misses",
+};
+
+const char *bench_perf_counter_name(enum bench_perf_counter counter) {
+    return s_counter_names[counter];
+}
+
+#ifdef __linux__
+
+#    include <linux/perf_event.h>
+#    include <sys/ioctl.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+
+static int s_open_counter(uint32_t type, uint64_t config, int group_fd) {
+
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.read_format = PERF_FORMAT_GROUP;
+    /* The leader starts disabled, and the rest of the group follows it */
+    attr.disabled = group_fd == -1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0);
+}
+
+int bench_perf_init(struct bench_perf *perf) {
+
+    const struct {
+        uint32_t type;
+        uint64_t config;
+    } events[BENCH_PERF_NUM_COUNTERS] = {
+        [BENCH_PERF_CYCLES] = {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        [BENCH_PERF_INSTRUCTIONS] = {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        [BENCH_PERF_BRANCH_MISSES] = {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+        [BENCH_PERF_L1D_MISSES] =
+            {PERF_TYPE_HW_CACHE,
+             PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+    };
+
+    /* The first counter that opens leads the group, so they are all read at once */
+    int group_fd = -1;
+    for (size_t i = 0; i < BENCH_PERF_NUM_COUNTERS; ++i) {
+        perf->fds[i] = s_open_counter(events[i].type, events[i].config, group_fd);
+        if (group_fd == -1) {
+            group_fd = perf->fds[i];
+        }
+    }
+
+    if (group_fd == -1) {
+        return AWS_OP_ERR;
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+void bench_perf_clean_up(struct bench_perf *perf) {
+
+    for (size_t i = 0; i < BENCH_PERF_NUM_COUNTERS; ++i) {
+        if (perf->fds[i] != -1) {
+            close(perf->fds[i]);
+            perf->fds[i] = -1;
+        }
+    }
+}
+
+static int s_leader_fd(struct bench_perf *perf) {
+
+    for (size_t i = 0; i < BENCH_PERF_NUM_COUNTERS; ++i) {
+        if (perf->fds[i] != -1) {
+            return perf->fds[i];
+        }
+    }
+    return -1;
+}
+
+void bench_perf_start(struct bench_perf *perf) {
+
+    const int leader_fd = s_leader_fd(perf);
+    ioctl(leader_fd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(leader_fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+int bench_perf_stop(struct bench_perf *perf, struct bench_perf_counters *counters) {
+
+    const int leader_fd = s_leader_fd(perf);
+    ioctl(leader_fd, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+    /* With PERF_FORMAT_GROUP, the leader reads the number of counters then each value, in the order they opened */
+    uint64_t values[1 + BENCH_PERF_NUM_COUNTERS];
+    if (read(leader_fd, values, sizeof(values)) < (ssize_t)sizeof(uint64_t)) {
+        return AWS_OP_ERR;
+    }
+
+    memset(counters, 0, sizeof(*counters));
+    size_t value_idx = 1;
+    for (size_t i = 0; i < BENCH_PERF_NUM_COUNTERS && value_idx <= values[0]; ++i) {
+        if (perf->fds[i] != -1) {
+            counters->available[i] = true;
+            counters->values[i] = values[value_idx++];
+        }
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+#else
+
+int bench_perf_init(struct bench_perf *perf) {
+    (void)perf;
+    return AWS_OP_ERR;
+}
+
+void bench_perf_clean_up(struct bench_perf *perf) {
+    (void)perf;
+}
+
+void bench_perf_start(struct bench_perf *perf) {
+    (void)perf;
+}
+
+int bench_perf_stop(struct bench_perf *perf, struct bench_perf_counters *counters) {
+    (void)perf;
+    memset(counters, 0, sizeof(*counters));
+    return AWS_OP_ERR;
+}
+
+#endif /* __linux__ */
@@ -0,0 +1,68 @@
+#ifndef AWS_COMPRESSION_BENCH_PERF_H
+#define AWS_COMPRESSION_BENCH_PERF_H
+
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/common/common.h>
+
+/**
+ * Optional hardware performance counters around a benchmark run, read with
+ * perf_event_open. Only available on Linux, and only when the kernel allows
+ * it (see /proc/sys/kernel/perf_event_paranoid).
+ */
+
+enum bench_perf_counter {
+    BENCH_PERF_CYCLES,
+    BENCH_PERF_INSTRUCTIONS,
+    BENCH_PERF_BRANCH_MISSES,
+    BENCH_PERF_L1D_MISSES,
+
+    BENCH_PERF_NUM_COUNTERS,
+};
+
+struct bench_perf_counters {
+    /** Which counters could be opened. The others are left at 0 */
+    bool available[BENCH_PERF_NUM_COUNTERS];
+    uint64_t values[BENCH_PERF_NUM_COUNTERS];
+};
+
+struct bench_perf {
+    int fds[BENCH_PERF_NUM_COUNTERS];
+};
+
+/**
+ * Opens the counters. Fails if none of them can be counted.
+ */
+int bench_perf_init(struct bench_perf *perf);
+
+void bench_perf_clean_up(struct bench_perf *perf);
+
+/**
+ * Resets and starts all the counters.
+ */
+void bench_perf_start(struct bench_perf *perf);
+
+/**
+ * Stops the counters and reads them into counters.
+ */
+int bench_perf_stop(struct bench_perf *perf, struct bench_perf_counters *counters);
+
+/**
+ * Name of a counter, as used in the JSON output.
+ */
+const char *bench_perf_counter_name(enum bench_perf_counter counter);
+
+#endif /* AWS_COMPRESSION_BENCH_PERF_H */
@@ -0,0 +1,655 @@
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "bench_perf.h"
+
+#include <aws/compression/huffman.h>
+#include <aws/compression/huffman_static_coder.h>
+
+#include <aws/common/clock.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#    include <intrin.h>
+#    define BENCH_HAVE_RDTSC
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#    include <x86intrin.h>
+#    define BENCH_HAVE_RDTSC
+#endif
+
+/* Exported by the generated files in tests/ */
+AWS_HUFFMAN_DECLARE_STATIC_CODER(test);
+AWS_HUFFMAN_DECLARE_STATIC_CODER(test_table);
+AWS_HUFFMAN_DECLARE_STATIC_CODER(test_multi);
+AWS_HUFFMAN_DECLARE_STATIC_CODER(test_canonical);
+
+enum {
+    CORPUS_SIZE = 64 * 1024,
+    /* Codes are at most 32 bits, so this always fits an encoded corpus */
+    ENCODED_CAPACITY = CORPUS_SIZE * 4,
+    COOKIE_SIZE = 4 * 1024,
+    CHUNK_SIZE = 16,
+    /* Roughly an HTTP/2 frame's share of a large header block */
+    FRAGMENT_SIZE = 1024,
+    MAX_FRAGMENTS = 16,
+    NUM_RUNS = 20,
+};
+
+typedef int(bench_encode_fn)(
+    struct aws_huffman_encoder *encoder,
+    struct aws_byte_cursor *to_encode,
+    struct aws_byte_buf *output);
+typedef int(bench_decode_fn)(
+    struct aws_huffman_decoder *decoder,
+    struct aws_byte_cursor *to_decode,
+    struct aws_byte_buf *output);
+
+struct bench_coder {
+    const char *name;
+    struct aws_huffman_symbol_coder *coder;
+    /* aws_huffman_encode and aws_huffman_decode, or a generated coder's specialized functions */
+    bench_encode_fn *encode;
+    bench_decode_fn *decode;
+};
+
+/* A corpus is a list of values, each of which is encoded or decoded with one call */
+struct bench_corpus {
+    const char *name;
+    uint8_t *data;
+    struct aws_byte_cursor *values;
+    size_t num_values;
+};
+
+/* Everything an operation needs: the corpus, and the corpus encoded with the coder */
+struct bench_input {
+    const struct bench_coder *coder;
+    const struct bench_corpus *corpus;
+    uint8_t *encoded_data;
+    struct aws_byte_cursor *encoded_values;
+    uint8_t *output;
+};
+
+/* How to run and report each benchmark, from the command line */
+struct bench_options {
+    /* NULL unless --perf was given and the counters could be opened */
+    struct bench_perf *perf;
+    bool json;
+    /* Number of results printed so far, to separate JSON objects */
+    size_t num_results;
+};
+
+typedef int(bench_op_fn)(struct bench_input *input);
+
+struct bench_op {
+    const char *name;
+    bench_op_fn *run;
+};
+
+static const char *s_header_names[] = {
+    "accept",
+    "accept-encoding",
+    "accept-language",
+    "authorization",
+    "cache-control",
+    "content-length",
+    "content-type",
+    "cookie",
+    "date",
+    "host",
+    "if-modified-since",
+    "referer",
+    "user-agent",
+    "x-amz-date",
+    "x-amz-security-token",
+    "x-forwarded-for",
+};
+
+static const char s_all_codes[] = " !\"#$%&'()*+,-./"
+                                  "0123456789:;<=>?@ABCDEFGHIJKLMNOPQRSTUVWXYZ["
+                                  "\\]^_`abcdefghijklmnopqrstuvwxyz{|}~";
+
+static const char s_base64_chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+/* Deterministic, so runs can be compared */
+static uint32_t s_random_state = 0x12345678;
+static uint32_t s_random(void) {
+    s_random_state = s_random_state * 1664525u + 1013904223u;
+    return s_random_state >> 8;
+}
+
+/* Returns cycles where a cycle counter is available, nanoseconds otherwise */
+static uint64_t s_read_cycles(void) {
+#ifdef BENCH_HAVE_RDTSC
+    return __rdtsc();
+#else
+    uint64_t ticks = 0;
+    aws_high_res_clock_get_ticks(&ticks);
+    return ticks;
+#endif
+}
+
+static uint64_t s_read_nanos(void) {
+    uint64_t ticks = 0;
+    aws_high_res_clock_get_ticks(&ticks);
+    return ticks;
+}
+
+static int s_corpus_init(struct bench_corpus *corpus, const char *name, size_t max_values) {
+
+    corpus->name = name;
+    corpus->data = malloc(CORPUS_SIZE);
+    corpus->values = malloc(max_values * sizeof(struct aws_byte_cursor));
+    corpus->num_values = 0;
+
+    return corpus->data && corpus->values ? AWS_OP_SUCCESS : AWS_OP_ERR;
+}
+
+static void s_corpus_clean_up(struct bench_corpus *corpus) {
+    free(corpus->data);
+    free(corpus->values);
+}
+
+/* Many short values, like the names in a header block */
+static int s_make_header_names(struct bench_corpus *corpus) {
+
+    if (s_corpus_init(corpus, "names", CORPUS_SIZE)) {
+        return AWS_OP_ERR;
+    }
+
+    size_t len = 0;
+    for (size_t i = 0;; ++i) {
+        const char *header_name = s_header_names[i % AWS_ARRAY_SIZE(s_header_names)];
+        const size_t header_name_len = strlen(header_name);
+        if (len + header_name_len > CORPUS_SIZE) {
+            break;
+        }
+
+        memcpy(corpus->data + len, header_name, header_name_len);
+        corpus->values[corpus->num_values++] = aws_byte_cursor_from_array(corpus->data + len, header_name_len);
+        len += header_name_len;
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+/* Long values of name=token pairs, like session cookies */
+static int s_make_cookies(struct bench_corpus *corpus) {
+
+    if (s_corpus_init(corpus, "cookies", CORPUS_SIZE / COOKIE_SIZE)) {
+        return AWS_OP_ERR;
+    }
+
+    for (size_t i = 0; i < CORPUS_SIZE; ++i) {
+        const size_t pos = i % 48;
+        uint8_t c = 0;
+        if (pos < 8) {
+            c = (uint8_t)("session_"[pos]);
+        } else if (pos == 8) {
+            c = '=';
+        } else if (pos == 46) {
+            c = ';';
+        } else if (pos == 47) {
+            c = ' ';
+        } else {
+            c = (uint8_t)s_base64_chars[s_random() % (sizeof(s_base64_chars) - 1)];
+        }
+        corpus->data[i] = c;
+    }
+
+    for (size_t i = 0; i < CORPUS_SIZE / COOKIE_SIZE; ++i) {
+        corpus->values[corpus->num_values++] = aws_byte_cursor_from_array(corpus->data + i * COOKIE_SIZE, COOKIE_SIZE);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+/* One value of uniformly random bytes, the worst case for any code */
+static int s_make_random(struct bench_corpus *corpus) {
+
+    if (s_corpus_init(corpus, "random", 1)) {
+        return AWS_OP_ERR;
+    }
+
+    for (size_t i = 0; i < CORPUS_SIZE; ++i) {
+        corpus->data[i] = (uint8_t)s_random();
+    }
+    corpus->values[corpus->num_values++] = aws_byte_cursor_from_array(corpus->data, CORPUS_SIZE);
+
+    return AWS_OP_SUCCESS;
+}
+
+/* One value cycling through every printable character */
+static int s_make_all_codes(struct bench_corpus *corpus) {
+
+    if (s_corpus_init(corpus, "all_codes", 1)) {
+        return AWS_OP_ERR;
+    }
+
+    for (size_t i = 0; i < CORPUS_SIZE; ++i) {
+        corpus->data[i] = (uint8_t)s_all_codes[i % (sizeof(s_all_codes) - 1)];
+    }
+    corpus->values[corpus->num_values++] = aws_byte_cursor_from_array(corpus->data, CORPUS_SIZE);
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_op_encode(struct bench_input *input) {
+
+    struct aws_huffman_encoder encoder;
+    aws_huffman_encoder_init(&encoder, input->coder->coder);
+    struct aws_byte_buf output_buf = aws_byte_buf_from_empty_array(input->output, ENCODED_CAPACITY);
+
+    for (size_t i = 0; i < input->corpus->num_values; ++i) {
+        aws_huffman_encoder_reset(&encoder);
+        struct aws_byte_cursor to_encode = input->corpus->values[i];
+        if (input->coder->encode(&encoder, &to_encode, &output_buf)) {
+            return AWS_OP_ERR;
+        }
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_op_encoded_length(struct bench_input *input) {
+
+    struct aws_huffman_encoder encoder;
+    aws_huffman_encoder_init(&encoder, input->coder->coder);
+
+    /* Stops the calls being optimized away */
+    volatile size_t total_length = 0;
+    for (size_t i = 0; i < input->corpus->num_values; ++i) {
+        total_length += aws_huffman_get_encoded_length(&encoder, input->corpus->values[i]);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_decode_values(struct bench_input *input, size_t chunk_size) {
+
+    struct aws_huffman_decoder decoder;
+    aws_huffman_decoder_init(&decoder, input->coder->coder);
+    struct aws_byte_buf output_buf = aws_byte_buf_from_empty_array(input->output, CORPUS_SIZE);
+
+    for (size_t i = 0; i < input->corpus->num_values; ++i) {
+        aws_huffman_decoder_reset(&decoder);
+        struct aws_byte_cursor to_decode = input->encoded_values[i];
+        const size_t expected_len = output_buf.len + input->corpus->values[i].len;
+
+        while (to_decode.len) {
+            struct aws_byte_cursor chunk =
+                aws_byte_cursor_advance(&to_decode, chunk_size < to_decode.len ? chunk_size : to_decode.len);
+            if (input->coder->decode(&decoder, &chunk, &output_buf)) {
+                return AWS_OP_ERR;
+            }
+        }
+
+        if (output_buf.len != expected_len) {
+            return AWS_OP_ERR;
+        }
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_op_decode(struct bench_input *input) {
+    return s_decode_values(input, SIZE_MAX);
+}
+
+static int s_op_decode_chunked(struct bench_input *input) {
+    return s_decode_values(input, CHUNK_SIZE);
+}
+
+/* Decodes each value from FRAGMENT_SIZE pieces in one call, as a header block split across frames would be */
+static int s_op_decode_gather(struct bench_input *input) {
+
+    struct aws_huffman_decoder decoder;
+    aws_huffman_decoder_init(&decoder, input->coder->coder);
+    struct aws_byte_buf output_buf = aws_byte_buf_from_empty_array(input->output, CORPUS_SIZE);
+
+    struct aws_byte_cursor fragments[MAX_FRAGMENTS];
+
+    for (size_t i = 0; i < input->corpus->num_values; ++i) {
+        aws_huffman_decoder_reset(&decoder);
+        struct aws_byte_cursor to_decode = input->encoded_values[i];
+        const size_t expected_len = output_buf.len + input->corpus->values[i].len;
+
+        while (to_decode.len) {
+            size_t num_fragments = 0;
+            while (to_decode.len && num_fragments < MAX_FRAGMENTS) {
+                fragments[num_fragments++] = aws_byte_cursor_advance(
+                    &to_decode, FRAGMENT_SIZE < to_decode.len ? FRAGMENT_SIZE : to_decode.len);
+            }
+            if (aws_huffman_decode_cursors(&decoder, fragments, num_fragments, &output_buf)) {
+                return AWS_OP_ERR;
+            }
+        }
+
+        if (output_buf.len != expected_len) {
+            return AWS_OP_ERR;
+        }
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+static struct bench_op s_ops[] = {
+    {.name = "encode", .run = s_op_encode},
+    {.name = "length", .run = s_op_encoded_length},
+    {.name = "decode", .run = s_op_decode},
+    {.name = "chunked", .run = s_op_decode_chunked},
+    {.name = "gather", .run = s_op_decode_gather},
+};
+
+/* Encodes each value of the corpus separately, as the decode operations expect */
+static int s_bench_input_init(
+    struct bench_input *input,
+    const struct bench_coder *coder,
+    const struct bench_corpus *corpus) {
+
+    AWS_ZERO_STRUCT(*input);
+    input->coder = coder;
+    input->corpus = corpus;
+    input->encoded_data = malloc(ENCODED_CAPACITY);
+    input->encoded_values = malloc(corpus->num_values * sizeof(struct aws_byte_cursor));
+    input->output = malloc(ENCODED_CAPACITY);
+    if (!input->encoded_data || !input->encoded_values || !input->output) {
+        return AWS_OP_ERR;
+    }
+
+    struct aws_huffman_encoder encoder;
+    aws_huffman_encoder_init(&encoder, coder->coder);
+    struct aws_byte_buf encoded_buf = aws_byte_buf_from_empty_array(input->encoded_data, ENCODED_CAPACITY);
+
+    for (size_t i = 0; i < corpus->num_values; ++i) {
+        aws_huffman_encoder_reset(&encoder);
+        const size_t start = encoded_buf.len;
+        struct aws_byte_cursor to_encode = corpus->values[i];
+        if (aws_huffman_encode(&encoder, &to_encode, &encoded_buf)) {
+            return AWS_OP_ERR;
+        }
+        input->encoded_values[i] = aws_byte_cursor_from_array(encoded_buf.buffer + start, encoded_buf.len - start);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+static void s_bench_input_clean_up(struct bench_input *input) {
+    free(input->encoded_data);
+    free(input->encoded_values);
+    free(input->output);
+}
+
+static void s_print_result(
+    struct bench_options *options,
+    const struct bench_op *op,
+    const struct bench_coder *bench_coder,
+    const struct bench_input *input,
+    uint64_t cycles,
+    uint64_t nanos,
+    const struct bench_perf_counters *counters) {
+
+    /* Rates are per byte of unencoded data, whichever way it is going */
+    const double cycles_per_byte = (double)cycles / (double)CORPUS_SIZE;
+    const double nanos_per_byte = (double)nanos / (double)CORPUS_SIZE;
+    const double mb_per_sec = (double)CORPUS_SIZE * 1000.0 / (double)nanos;
+
+    if (options->json) {
+        printf(
+            "%s\n  {\"op\": \"%s\", \"corpus\": \"%s\", \"coder\": \"%s\", \"kernels\": \"%s\", \"bytes\": %u, "
+            "\"%s\": %.3f, \"ns_per_byte\": %.3f, \"mb_per_sec\": %.1f",
+            options->num_results ? "," : "",
+            op->name,
+            input->corpus->name,
+            bench_coder->name,
+            aws_huffman_get_kernels_name(),
+            (unsigned)CORPUS_SIZE,
+#ifdef BENCH_HAVE_RDTSC
+            "cycles_per_byte",
+#else
+            "ticks_per_byte",
+#endif
+            cycles_per_byte,
+            nanos_per_byte,
+            mb_per_sec);
+
+        if (options->perf) {
+            printf(", \"counters\": {");
+            for (size_t i = 0; i < BENCH_PERF_NUM_COUNTERS; ++i) {
+                printf("%s\"%s\": ", i ? ", " : "", bench_perf_counter_name((enum bench_perf_counter)i));
+                if (counters->available[i]) {
+                    printf("%llu", (unsigned long long)counters->values[i]);
+                } else {
+                    printf("null");
+                }
+            }
+            printf("}");
+        }
+        printf("}");
+
+    } else {
+        printf(
+            "%-8s %-10s %-12s %8.2f %8.2f %10.1f",
+            op->name,
+            input->corpus->name,
+            bench_coder->name,
+            cycles_per_byte,
+            nanos_per_byte,
+            mb_per_sec);
+
+        if (options->perf) {
+            const uint64_t *values = counters->values;
+            printf(
+                " %6.2f %10.2f %10.2f",
+                values[BENCH_PERF_CYCLES] ? (double)values[BENCH_PERF_INSTRUCTIONS] / (double)values[BENCH_PERF_CYCLES]
+                                          : 0.0,
+                (double)values[BENCH_PERF_BRANCH_MISSES] * 1024.0 / (double)CORPUS_SIZE,
+                (double)values[BENCH_PERF_L1D_MISSES] * 1024.0 / (double)CORPUS_SIZE);
+        }
+        printf("\n");
+    }
+
+    ++options->num_results;
+}
+
+static int s_bench_op(
+    struct bench_options *options,
+    const struct bench_op *op,
+    const struct bench_coder *bench_coder,
+    struct bench_input *input) {
+
+    uint64_t best_cycles = UINT64_MAX;
+    uint64_t best_nanos = UINT64_MAX;
+    struct bench_perf_counters best_counters;
+    AWS_ZERO_STRUCT(best_counters);
+
+    for (size_t run = 0; run < NUM_RUNS; ++run) {
+        if (options->perf) {
+            bench_perf_start(options->perf);
+        }
+
+        const uint64_t start_nanos = s_read_nanos();
+        const uint64_t start_cycles = s_read_cycles();
+
+        int result = op->run(input);
+
+        const uint64_t cycles = s_read_cycles() - start_cycles;
+        const uint64_t nanos = s_read_nanos() - start_nanos;
+
+        struct bench_perf_counters counters;
+        AWS_ZERO_STRUCT(counters);
+        if (options->perf && bench_perf_stop(options->perf, &counters)) {
+            fprintf(stderr, "Failed to read performance counters\n");
+            return AWS_OP_ERR;
+        }
+
+        if (result != AWS_OP_SUCCESS) {
+            fprintf(stderr, "%s %s %s: failed\n", op->name, input->corpus->name, bench_coder->name);
+            return AWS_OP_ERR;
+        }
+
+        /* Report the counters from the fastest run, along with its time */
+        if (cycles < best_cycles) {
+            best_cycles = cycles;
+            best_counters = counters;
+        }
+        best_nanos = nanos < best_nanos ? nanos : best_nanos;
+    }
+
+    s_print_result(options, op, bench_coder, input, best_cycles, best_nanos, &best_counters);
+
+    return AWS_OP_SUCCESS;
+}
+
+static void s_print_usage(void) {
+    fprintf(
+        stderr,
+        "usage: aws-c-compression-bench [options]\n"
+        "Options:\n"
+        "  --perf   Also read hardware performance counters around each run (Linux only)\n"
+        "  --json   Print the results as a JSON array\n"
+        "  --scalar Use only the scalar kernels, as AWS_COMPRESSION_FORCE_SCALAR=1 does\n");
+}
+
+int main(int argc, char *argv[]) {
+
+    struct aws_allocator *allocator = aws_default_allocator();
+    int result = 1;
+
+    struct bench_options options;
+    AWS_ZERO_STRUCT(options);
+    bool use_perf = false;
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--perf") == 0) {
+            use_perf = true;
+        } else if (strcmp(argv[i], "--json") == 0) {
+            options.json = true;
+        } else if (strcmp(argv[i], "--scalar") == 0) {
+            aws_huffman_force_scalar_kernels(true);
+        } else {
+            s_print_usage();
+            return 1;
+        }
+    }
+
+    struct bench_perf perf;
+    if (use_perf) {
+        if (bench_perf_init(&perf)) {
+            fprintf(stderr, "Performance counters are not available, continuing without them\n");
+        } else {
+            options.perf = &perf;
+        }
+    }
+
+    struct bench_corpus corpora[4];
+    AWS_ZERO_ARRAY(corpora);
+
+    /* Also measure a coder built at runtime for the same code lengths */
+    struct aws_huffman_symbol_coder *canonical_coder =
+        aws_huffman_coder_new_from_lengths(allocator, test_get_coder()->code_lengths);
+
+    struct bench_coder coders[] = {
+        {.name = "tree", .coder = test_get_coder(), .encode = aws_huffman_encode, .decode = aws_huffman_decode},
+        {.name = "table", .coder = test_table_get_coder(), .encode = aws_huffman_encode, .decode = aws_huffman_decode},
+        {.name = "multi", .coder = test_multi_get_coder(), .encode = aws_huffman_encode, .decode = aws_huffman_decode},
+        {.name = "limits",
+         .coder = test_canonical_get_coder(),
+         .encode = aws_huffman_encode,
+         .decode = aws_huffman_decode},
+        {.name = "canonical", .coder = canonical_coder, .encode = aws_huffman_encode, .decode = aws_huffman_decode},
+        /* The same generated coders, through their specialized encode and decode functions */
+        {.name = "tree/spec", .coder = test_get_coder(), .encode = test_encode, .decode = test_decode},
+        {.name = "table/spec",
+         .coder = test_table_get_coder(),
+         .encode = test_table_encode,
+         .decode = test_table_decode},
+        {.name = "multi/spec",
+         .coder = test_multi_get_coder(),
+         .encode = test_multi_encode,
+         .decode = test_multi_decode},
+        {.name = "limits/spec",
+         .coder = test_canonical_get_coder(),
+         .encode = test_canonical_encode,
+         .decode = test_canonical_decode},
+    };
+
+    if (!canonical_coder || s_make_header_names(&corpora[0]) || s_make_cookies(&corpora[1]) ||
+        s_make_random(&corpora[2]) || s_make_all_codes(&corpora[3])) {
+        fprintf(stderr, "Failed to set up the benchmark\n");
+        goto clean_up;
+    }
+
+    if (options.json) {
+        printf("[");
+    } else {
+        printf("kernels: %s\n", aws_huffman_get_kernels_name());
+        printf(
+            "%-8s %-10s %-12s %8s %8s %10s",
+            "op",
+            "corpus",
+            "coder",
+#ifdef BENCH_HAVE_RDTSC
+            "cyc/B",
+#else
+            "ticks/B",
+#endif
+            "ns/B",
+            "MB/s");
+        if (options.perf) {
+            printf(" %6s %10s %10s", "IPC", "brmiss/KB", "l1dmiss/KB");
+        }
+        printf("\n");
+    }
+
+    for (size_t corpus_idx = 0; corpus_idx < AWS_ARRAY_SIZE(corpora); ++corpus_idx) {
+        for (size_t coder_idx = 0; coder_idx < AWS_ARRAY_SIZE(coders); ++coder_idx) {
+            struct bench_input input;
+            if (s_bench_input_init(&input, &coders[coder_idx], &corpora[corpus_idx])) {
+                fprintf(stderr, "Failed to encode %s\n", corpora[corpus_idx].name);
+                s_bench_input_clean_up(&input);
+                goto clean_up;
+            }
+
+            for (size_t op_idx = 0; op_idx < AWS_ARRAY_SIZE(s_ops); ++op_idx) {
+                if (s_bench_op(&options, &s_ops[op_idx], &coders[coder_idx], &input)) {
+                    s_bench_input_clean_up(&input);
+                    goto clean_up;
+                }
+            }
+
+            s_bench_input_clean_up(&input);
+        }
+    }
+
+    if (options.json) {
+        printf("\n]\n");
+    }
+
+    result = 0;
+
+clean_up:
+    if (options.perf) {
+        bench_perf_clean_up(options.perf);
+    }
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(corpora); ++i) {
+        s_corpus_clean_up(&corpora[i]);
+    }
+    aws_huffman_coder_destroy(canonical_coder);
+
+    return result;
+}
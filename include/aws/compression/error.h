@@ -21,6 +21,7 @@
 
 enum aws_compression_error {
     AWS_ERROR_COMPRESSION_UNKNOWN_SYMBOL = 0x0C00,
+    AWS_ERROR_COMPRESSION_INVALID_CODE_LENGTHS,
 
     AWS_ERROR_END_COMPRESSION_RANGE = 0x1000
 };
@@ -18,8 +18,10 @@
 
 #include <aws/compression/exports.h>
 
+#include <aws/common/atomics.h>
 #include <aws/common/byte_buf.h>
 #include <aws/common/common.h>
+#include <aws/common/math.h>
 
 #include <stddef.h>
 
@@ -36,6 +38,20 @@ struct aws_huffman_code {
     uint8_t num_bits;
 };
 
+/**
+ * The longest code that fits in an aws_huffman_symbol_coder packed_codes
+ * entry, which holds a code as (1u << num_bits) | pattern: the highest set bit
+ * marks where the pattern ends, so the entry doesn't spend bits on the length.
+ * This covers HPACK's 30 bit codes.
+ */
+#define AWS_HUFFMAN_PACKED_MAX_CODE_LENGTH 31
+
+/** The number of bits in the code of a non-zero packed_codes entry */
+#define AWS_HUFFMAN_PACKED_NUM_BITS(packed) ((uint8_t)(31 - aws_clz_u32(packed)))
+
+/** The pattern of a non-zero packed_codes entry, given its AWS_HUFFMAN_PACKED_NUM_BITS */
+#define AWS_HUFFMAN_PACKED_PATTERN(packed, num_bits) ((packed) ^ (1u << (num_bits)))
+
 /**
  * Function used to encode a single symbol to an aws_huffman_code
  *
@@ -58,13 +74,170 @@ typedef struct aws_huffman_code(aws_huffman_symbol_encoder_fn)(uint8_t symbol, v
  */
 typedef uint8_t(aws_huffman_symbol_decoder_fn)(uint32_t bits, uint8_t *symbol, void *userdata);
 
+/**
+ * The maximum number of symbols an aws_huffman_symbol_multi_decoder_fn may
+ * decode from a single call
+ */
+#define AWS_HUFFMAN_MAX_DECODE_SYMBOLS 4
+
+/**
+ * Function used to decode as many whole codes as possible from the front of
+ * bits in one step
+ *
+ * \param[in]   bits        The bits to attept to decode symbols from
+ * \param[out]  symbols     The symbols found, in order. Has room for
+ * AWS_HUFFMAN_MAX_DECODE_SYMBOLS symbols
+ * \param[out]  num_symbols The number of symbols written to symbols
+ * \param[in]   userdata    Optional userdata
+ * (aws_huffman_symbol_coder.userdata)
+ *
+ * \returns The total number of bits read from bits, or 0 if no valid symbol
+ * was found
+ */
+typedef uint8_t(
+    aws_huffman_symbol_multi_decoder_fn)(uint32_t bits, uint8_t *symbols, uint8_t *num_symbols, void *userdata);
+
+/**
+ * Why a step of encoding or decoding stopped. Running out of input or output
+ * is a normal part of streaming, so only AWS_HUFFMAN_ERROR raises an error.
+ */
+enum aws_huffman_status {
+    /** All of the input was encoded, and the output padded to a whole byte */
+    AWS_HUFFMAN_DONE,
+    /** All of the input was read. Any bits that don't make a whole byte or code are held until the next call */
+    AWS_HUFFMAN_NEED_INPUT,
+    /** output is full. Call again with more room to continue */
+    AWS_HUFFMAN_NEED_OUTPUT,
+    /** An error was raised, such as AWS_ERROR_COMPRESSION_UNKNOWN_SYMBOL */
+    AWS_HUFFMAN_ERROR,
+};
+
+struct aws_huffman_decoder;
+
+/**
+ * Function used to decode a whole buffer at once, in place of calling decode
+ * once per symbol. Must behave exactly like aws_huffman_decode_step, which
+ * dispatches to it (after checking that output has room).
+ *
+ * \param[in]       decoder         The decoder object to use
+ * \param[in]       to_decode       The encoded byte buffer to read from
+ * \param[in]       output          The buffer to write decoded symbols to
+ * \param[in]       userdata        Optional userdata
+ * (aws_huffman_symbol_coder.userdata)
+ *
+ * \return AWS_HUFFMAN_NEED_INPUT once all of to_decode is read,
+ * AWS_HUFFMAN_NEED_OUTPUT if output fills first, or AWS_HUFFMAN_ERROR after
+ * raising an error
+ */
+typedef enum aws_huffman_status(aws_huffman_decode_buffer_fn)(
+    struct aws_huffman_decoder *decoder,
+    struct aws_byte_cursor *to_decode,
+    struct aws_byte_buf *output,
+    void *userdata);
+
 /**
  * Structure used to define how symbols are encoded and decoded
  */
 struct aws_huffman_symbol_coder {
     aws_huffman_symbol_encoder_fn *encode;
     aws_huffman_symbol_decoder_fn *decode;
+    /** Optional. If set, used in place of decode when there is room for all of the symbols it returns */
+    aws_huffman_symbol_multi_decoder_fn *decode_multi;
+    /** Optional. If set, decoding calls this instead of running its own loop */
+    aws_huffman_decode_buffer_fn *decode_buffer;
     void *userdata;
+
+    /*
+     * Optional metadata describing the code, which lets the encoder and
+     * decoder avoid calling back per symbol. Leave zeroed if unknown.
+     */
+
+    /** 256 entries, the number of bits in each symbol's code (0 if the symbol has no code) */
+    const uint8_t *code_lengths;
+    /** The number of bits in the shortest code */
+    uint8_t min_code_length;
+    /** The number of bits in the longest code */
+    uint8_t max_code_length;
+    /**
+     * 256 entries, each symbol's code packed as (1u << num_bits) | pattern. Encoding reads these directly instead
+     * of calling encode, except for entries of 0 (symbols without a code, or with a code longer than
+     * AWS_HUFFMAN_PACKED_MAX_CODE_LENGTH)
+     */
+    const uint32_t *packed_codes;
+};
+
+/**
+ * Optional counters for an encoder or decoder. Each is only written by the
+ * thread using the encoder or decoder, and may be read from any thread with
+ * aws_huffman_stats_snapshot. Counting happens once per call, not per symbol.
+ */
+struct aws_huffman_stats {
+    /** Calls to aws_huffman_encode or aws_huffman_decode */
+    struct aws_atomic_var num_calls;
+    /** Symbols encoded or decoded */
+    struct aws_atomic_var num_symbols;
+    /** Bytes read from the input cursor */
+    struct aws_atomic_var num_bytes_in;
+    /** Bytes written to the output buffer */
+    struct aws_atomic_var num_bytes_out;
+    /** Calls that ran out of output (AWS_ERROR_SHORT_BUFFER or AWS_HUFFMAN_NEED_OUTPUT) */
+    struct aws_atomic_var num_short_buffer;
+    /** Calls that returned with bits carried over to the next call */
+    struct aws_atomic_var num_carries;
+    /** Sum of the bits carried over at each return */
+    struct aws_atomic_var num_pending_bits;
+};
+
+/**
+ * A copy of aws_huffman_stats at one point in time
+ */
+struct aws_huffman_stats_snapshot {
+    size_t num_calls;
+    size_t num_symbols;
+    size_t num_bytes_in;
+    size_t num_bytes_out;
+    size_t num_short_buffer;
+    size_t num_carries;
+    size_t num_pending_bits;
+};
+
+/**
+ * Samples the symbols passed to an encoder into a histogram: every period-th
+ * byte is counted, carrying the position across calls. Like
+ * aws_huffman_stats, only the thread using the encoder writes it, and it
+ * may be merged into a histogram from any thread.
+ */
+struct aws_huffman_sampler {
+    struct aws_atomic_var counts[256];
+    /** Count one byte in every period */
+    size_t period;
+    /** Offset of the next byte to count, from the start of the next input */
+    size_t next_offset;
+};
+
+/**
+ * A symbol histogram, merged from samplers. Its counts may be passed to
+ * aws_huffman_code_lengths_from_frequencies to retrain a code.
+ */
+struct aws_huffman_histogram {
+    uint64_t counts[256];
+};
+
+/**
+ * How well a histogram's symbols are coded
+ */
+struct aws_huffman_entropy_report {
+    /** Number of symbols in the histogram */
+    uint64_t num_symbols;
+    /** Shannon entropy of the histogram, the lower bound for any code, in bits per symbol */
+    double entropy;
+    /** Average length of the given coder's codes, in bits per symbol */
+    double coder_bits;
+    /**
+     * Average length of the best code for the histogram (no longer than 32 bits), in bits per symbol. This is the
+     * code aws_huffman_code_lengths_from_frequencies builds, which leaves a code unused for the end of stream
+     */
+    double optimal_bits;
 };
 
 /**
@@ -75,9 +248,21 @@ struct aws_huffman_encoder {
     /* Params */
     struct aws_huffman_symbol_coder *coder;
     uint8_t eos_padding;
+    /** Optional, set after init to count calls. Kept across reset */
+    struct aws_huffman_stats *stats;
+    /** Optional, set after init to sample the symbols encoded. Kept across reset */
+    struct aws_huffman_sampler *sampler;
 
     /* State */
     struct aws_huffman_code overflow_bits;
+
+    /*
+     * For coders without code_lengths: each symbol's code length, probed from
+     * encode the first time a length is summed, and kept across reset.
+     * probed_coder is the coder they were probed from, or NULL if not yet probed.
+     */
+    struct aws_huffman_symbol_coder *probed_coder;
+    uint8_t probed_code_lengths[256];
 };
 
 /**
@@ -87,6 +272,8 @@ struct aws_huffman_encoder {
 struct aws_huffman_decoder {
     /* Param */
     struct aws_huffman_symbol_coder *coder;
+    /** Optional, set after init to count calls. Kept across reset */
+    struct aws_huffman_stats *stats;
 
     /* State */
     uint64_t working_bits;
@@ -95,6 +282,142 @@ struct aws_huffman_decoder {
 
 AWS_EXTERN_C_BEGIN
 
+/**
+ * Compute optimal code lengths for a set of symbol frequencies, with no code
+ * longer than max_code_length bits (package-merge). Symbols with a frequency of
+ * 0 get a length of 0, and so have no code.
+ *
+ * So that the end of stream padding never decodes as a symbol, the code is
+ * built with an extra end of stream symbol that never occurs, like HPACK's EOS,
+ * and the all 1s code it gets in the canonical code is left unused. (The one
+ * exception is all 256 symbols in 8 bits, where every code is longer than the
+ * padding.) A single symbol therefore gets a 1 bit code, with the other unused.
+ *
+ * \param[in]       frequencies     256 entries, how often each symbol occurs. The sum must fit in 64 bits.
+ * \param[in]       max_code_length The longest code allowed, from 1 to 32 bits
+ * \param[out]      code_lengths    256 entries, the number of bits in each symbol's code
+ *
+ * \return AWS_OP_SUCCESS, or AWS_OP_ERR with AWS_ERROR_INVALID_ARGUMENT if no symbol occurs or
+ * the symbols that do, and the end of stream symbol, can't all fit in max_code_length bits.
+ */
+AWS_COMPRESSION_API
+int aws_huffman_code_lengths_from_frequencies(
+    const uint64_t *frequencies,
+    uint8_t max_code_length,
+    uint8_t *code_lengths);
+
+/**
+ * Assign the canonical Huffman code for a set of code lengths: codes are
+ * assigned in order of length, then symbol, as DEFLATE and HPACK do. Symbols
+ * with a length of 0 have no code.
+ *
+ * \param[in]       code_lengths    256 entries, the number of bits in each symbol's code (up to 32)
+ * \param[out]      codes           256 entries, each symbol's code
+ *
+ * \return AWS_OP_SUCCESS, or AWS_OP_ERR with AWS_ERROR_COMPRESSION_INVALID_CODE_LENGTHS if the
+ * lengths don't describe a prefix code.
+ */
+AWS_COMPRESSION_API
+int aws_huffman_assign_canonical_codes(const uint8_t *code_lengths, struct aws_huffman_code *codes);
+
+/**
+ * Create a symbol coder for the canonical Huffman code with the given code
+ * lengths, as used by DEFLATE and HPACK: codes are assigned in order of length,
+ * then symbol. Symbols with a length of 0 have no code.
+ *
+ * \param[in]       allocator       The allocator to use for the coder
+ * \param[in]       code_lengths    256 entries, the number of bits in each symbol's code (up to 32)
+ *
+ * The last byte of an encoding is padded with up to 7 bits of eos_padding (all 1s by default), which must not decode
+ * as a symbol. Canonical codes leave the all 1s code unused when the code is incomplete, and the coder reports a
+ * max_code_length of at least 8 so that decoders take the padding as an unfinished code. When the code is complete and
+ * its all 1s code is 7 bits or shorter, the lengths are rejected.
+ *
+ * \return The new coder, or NULL on failure. Raises AWS_ERROR_COMPRESSION_INVALID_CODE_LENGTHS
+ * if the lengths don't describe a prefix code, or give a symbol the all 1s code in 7 bits or fewer.
+ */
+AWS_COMPRESSION_API
+struct aws_huffman_symbol_coder *aws_huffman_coder_new_from_lengths(
+    struct aws_allocator *allocator,
+    const uint8_t *code_lengths);
+
+/**
+ * Destroy a coder created by aws_huffman_coder_new_from_lengths.
+ */
+AWS_COMPRESSION_API
+void aws_huffman_coder_destroy(struct aws_huffman_symbol_coder *coder);
+
+/**
+ * Zero a statistics block, before pointing an encoder or decoder at it.
+ */
+AWS_COMPRESSION_API
+void aws_huffman_stats_init(struct aws_huffman_stats *stats);
+
+/**
+ * Read every counter in stats. Safe to call from any thread while the stats
+ * are being updated, though counters from the same call may be seen torn
+ * across each other.
+ */
+AWS_COMPRESSION_API
+void aws_huffman_stats_snapshot(const struct aws_huffman_stats *stats, struct aws_huffman_stats_snapshot *snapshot);
+
+/**
+ * Initialize a sampler to count one byte in every period (at least 1).
+ */
+AWS_COMPRESSION_API
+void aws_huffman_sampler_init(struct aws_huffman_sampler *sampler, size_t period);
+
+/**
+ * Sample a buffer of symbols. aws_huffman_encode calls this with the symbols
+ * it consumed when the encoder has a sampler.
+ */
+AWS_COMPRESSION_API
+void aws_huffman_sampler_sample(struct aws_huffman_sampler *sampler, struct aws_byte_cursor symbols);
+
+/**
+ * Zero a histogram.
+ */
+AWS_COMPRESSION_API
+void aws_huffman_histogram_init(struct aws_huffman_histogram *histogram);
+
+/**
+ * Count every byte of symbols into a histogram, for example to train a code
+ * on sample data.
+ */
+AWS_COMPRESSION_API
+void aws_huffman_histogram_add_symbols(struct aws_huffman_histogram *histogram, struct aws_byte_cursor symbols);
+
+/**
+ * Add a sampler's counts to a histogram. Safe to call from any thread while
+ * the sampler is in use.
+ */
+AWS_COMPRESSION_API
+void aws_huffman_histogram_add_sampler(
+    struct aws_huffman_histogram *histogram,
+    const struct aws_huffman_sampler *sampler);
+
+/**
+ * Add one histogram's counts to another.
+ */
+AWS_COMPRESSION_API
+void aws_huffman_histogram_merge(struct aws_huffman_histogram *histogram, const struct aws_huffman_histogram *other);
+
+/**
+ * Compare a histogram's entropy with the code lengths of a coder, and of the
+ * best code retrained on the histogram.
+ *
+ * \param[in]       histogram       The symbols to report on
+ * \param[in]       coder           The coder to compare against
+ * \param[out]      report          The results
+ *
+ * \return AWS_OP_SUCCESS, or AWS_OP_ERR with AWS_ERROR_INVALID_ARGUMENT if the histogram is empty
+ */
+AWS_COMPRESSION_API
+int aws_huffman_histogram_report(
+    const struct aws_huffman_histogram *histogram,
+    struct aws_huffman_symbol_coder *coder,
+    struct aws_huffman_entropy_report *report);
+
 /**
  * Initialize a encoder object with a symbol coder.
  */
@@ -145,6 +468,111 @@ int aws_huffman_encode(
     struct aws_byte_cursor *to_encode,
     struct aws_byte_buf *output);
 
+/**
+ * Encode one piece of a symbol stream, for input that arrives in pieces.
+ * Unlike aws_huffman_encode, this doesn't pad the output to a whole byte: any
+ * partial byte is kept in the encoder for the next call, and only written out
+ * by aws_huffman_encode_finish.
+ *
+ * \param[in]       encoder         The encoder object to use
+ * \param[in]       to_encode       The symbol buffer to encode
+ * \param[in]       output          The buffer to write encoded bytes to
+ *
+ * \return AWS_OP_SUCCESS if encoding is successful, AWS_OP_ERR otherwise
+ */
+AWS_COMPRESSION_API
+int aws_huffman_encode_update(
+    struct aws_huffman_encoder *encoder,
+    struct aws_byte_cursor *to_encode,
+    struct aws_byte_buf *output);
+
+/**
+ * Finish a stream encoded with aws_huffman_encode_update, writing any bits
+ * still held by the encoder padded with eos_padding. If this fails with
+ * AWS_ERROR_SHORT_BUFFER, call it again with more room.
+ *
+ * \param[in]       encoder         The encoder object to use
+ * \param[in]       output          The buffer to write encoded bytes to
+ *
+ * \return AWS_OP_SUCCESS if encoding is successful, AWS_OP_ERR otherwise
+ */
+AWS_COMPRESSION_API
+int aws_huffman_encode_finish(struct aws_huffman_encoder *encoder, struct aws_byte_buf *output);
+
+/**
+ * Encode one piece of a symbol stream, reporting how it stopped instead of
+ * raising AWS_ERROR_SHORT_BUFFER. to_encode is advanced past the symbols
+ * consumed, and output->len past the bytes produced.
+ *
+ * \param[in]       encoder         The encoder object to use
+ * \param[in]       to_encode       The symbol buffer to encode
+ * \param[in]       output          The buffer to write encoded bytes to
+ * \param[in]       finish          If true, to_encode ends the stream and the output is padded with eos_padding
+ *                                  (like aws_huffman_encode). If false, the partial byte is held in the encoder
+ *                                  (like aws_huffman_encode_update)
+ *
+ * \return AWS_HUFFMAN_DONE when finished, AWS_HUFFMAN_NEED_INPUT when all of to_encode was encoded but finish is
+ * false, AWS_HUFFMAN_NEED_OUTPUT when output is full, or AWS_HUFFMAN_ERROR after raising an error
+ */
+AWS_COMPRESSION_API
+enum aws_huffman_status aws_huffman_encode_step(
+    struct aws_huffman_encoder *encoder,
+    struct aws_byte_cursor *to_encode,
+    struct aws_byte_buf *output,
+    bool finish);
+
+/**
+ * Encode a symbol buffer into output, growing output first so the whole
+ * buffer fits. output must own its memory (see aws_byte_buf_init), and is
+ * grown once, to the exact encoded length, with aws_byte_buf_reserve.
+ *
+ * \param[in]       encoder         The encoder object to use
+ * \param[in]       to_encode       The symbol buffer to encode
+ * \param[in]       output          The buffer to write encoded bytes to
+ *
+ * \return AWS_OP_SUCCESS if encoding is successful, AWS_OP_ERR otherwise
+ */
+AWS_COMPRESSION_API
+int aws_huffman_encode_dynamic(
+    struct aws_huffman_encoder *encoder,
+    struct aws_byte_cursor *to_encode,
+    struct aws_byte_buf *output);
+
+/**
+ * Replace the symbols in buf with their encoding, padded with eos_padding,
+ * without a second buffer. This is only possible when the encoding is no
+ * longer than buf->len, and no prefix of it is longer than the symbols it
+ * encodes (so writing never overtakes reading). Both are checked before
+ * anything is written: if either fails, AWS_ERROR_SHORT_BUFFER is raised and
+ * buf is left unchanged, so the caller can encode into a separate buffer
+ * instead.
+ *
+ * \param[in]       encoder         The encoder object to use
+ * \param[in,out]   buf             In: The symbols to encode. Out: The encoded bytes
+ *
+ * \return AWS_OP_SUCCESS if encoding is successful, AWS_OP_ERR otherwise
+ */
+AWS_COMPRESSION_API
+int aws_huffman_encode_in_place(struct aws_huffman_encoder *encoder, struct aws_byte_buf *buf);
+
+/**
+ * Get the number of symbols aws_huffman_decode would write when decoding
+ * to_decode from the decoder's current state, given enough output space.
+ * Trailing bits that don't form a whole code are not counted, just as they
+ * aren't decoded. The decoder is not modified.
+ *
+ * \param[in]       decoder         The decoder object to use
+ * \param[in]       to_decode       The encoded byte buffer to measure
+ * \param[out]      out_length      The number of symbols to_decode decodes to
+ *
+ * \return AWS_OP_SUCCESS if the length is known, AWS_OP_ERR if to_decode contains an unknown symbol
+ */
+AWS_COMPRESSION_API
+int aws_huffman_get_decoded_length(
+    struct aws_huffman_decoder *decoder,
+    struct aws_byte_cursor to_decode,
+    size_t *out_length);
+
 /**
  * Decodes a byte buffer into the provided symbol array.
  *
@@ -160,6 +588,84 @@ int aws_huffman_decode(
     struct aws_byte_cursor *to_decode,
     struct aws_byte_buf *output);
 
+/**
+ * Decodes a byte buffer into the provided symbol array, reporting how it
+ * stopped instead of raising AWS_ERROR_SHORT_BUFFER. to_decode is advanced
+ * past the bytes consumed, and output->len past the symbols produced. The
+ * decoder can't tell where a stream ends, so this never returns
+ * AWS_HUFFMAN_DONE: once the caller has no more input, the stream is done.
+ *
+ * \param[in]       decoder         The decoder object to use
+ * \param[in]       to_decode       The encoded byte buffer to read from
+ * \param[in]       output          The buffer to write decoded symbols to
+ *
+ * \return AWS_HUFFMAN_NEED_INPUT when all of to_decode was read, AWS_HUFFMAN_NEED_OUTPUT when output is full, or
+ * AWS_HUFFMAN_ERROR after raising an error
+ */
+AWS_COMPRESSION_API
+enum aws_huffman_status aws_huffman_decode_step(
+    struct aws_huffman_decoder *decoder,
+    struct aws_byte_cursor *to_decode,
+    struct aws_byte_buf *output);
+
+/**
+ * Decodes a byte buffer into output, growing output first so all of the
+ * symbols fit. output must own its memory (see aws_byte_buf_init), and is
+ * grown once with aws_byte_buf_reserve, to the most symbols the input could
+ * hold given the coder's min_code_length (or one per bit if that is not set).
+ *
+ * \param[in]       decoder         The decoder object to use
+ * \param[in]       to_decode       The encoded byte buffer to read from
+ * \param[in]       output          The buffer to write decoded symbols to
+ *
+ * \return AWS_OP_SUCCESS if decoding is successful, AWS_OP_ERR otherwise
+ */
+AWS_COMPRESSION_API
+int aws_huffman_decode_dynamic(
+    struct aws_huffman_decoder *decoder,
+    struct aws_byte_cursor *to_decode,
+    struct aws_byte_buf *output);
+
+/**
+ * Decodes a byte buffer split across several cursors (for example the
+ * fragments of an HTTP/2 header block) into the provided symbol array, as if
+ * they were one contiguous buffer. Codes may span fragments. Each cursor is
+ * advanced past the bytes read from it, so after AWS_ERROR_SHORT_BUFFER the
+ * same array may be passed again to continue.
+ *
+ * \param[in]       decoder         The decoder object to use
+ * \param[in]       to_decode       The encoded byte buffers to read from, in order
+ * \param[in]       num_cursors     The number of cursors in to_decode
+ * \param[in]       output          The buffer to write decoded symbols to
+ *
+ * \return AWS_OP_SUCCESS if decoding is successful, AWS_OP_ERR otherwise
+ */
+AWS_COMPRESSION_API
+int aws_huffman_decode_cursors(
+    struct aws_huffman_decoder *decoder,
+    struct aws_byte_cursor *to_decode,
+    size_t num_cursors,
+    struct aws_byte_buf *output);
+
+/**
+ * Use only the scalar kernels from now on, or go back to the widest kernels
+ * the CPU supports. Kernels are otherwise chosen on first use, and setting the
+ * AWS_COMPRESSION_FORCE_SCALAR environment variable to anything but empty or
+ * "0" forces the scalar ones. Every kernel gives the same results, so this is
+ * safe to call while other threads are encoding or decoding.
+ *
+ * \param[in]       force_scalar    true to use the scalar kernels, false to detect CPU features
+ */
+AWS_COMPRESSION_API
+void aws_huffman_force_scalar_kernels(bool force_scalar);
+
+/**
+ * Returns the name of the kernels in use ("scalar" or "avx2"), choosing them
+ * if this is the first use.
+ */
+AWS_COMPRESSION_API
+const char *aws_huffman_get_kernels_name(void);
+
 AWS_EXTERN_C_END
 
 #endif /* AWS_COMPRESSION_HUFFMAN_H */
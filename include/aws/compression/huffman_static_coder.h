@@ -0,0 +1,136 @@
+#ifndef AWS_COMPRESSION_HUFFMAN_STATIC_CODER_H
+#define AWS_COMPRESSION_HUFFMAN_STATIC_CODER_H
+
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/compression/huffman.h>
+
+#include <aws/common/byte_order.h>
+#include <aws/common/error.h>
+
+#include <string.h>
+
+/**
+ * Declares the functions AWS_HUFFMAN_DEFINE_STATIC_CODER defines for name, for use in headers
+ */
+#define AWS_HUFFMAN_DECLARE_STATIC_CODER(name)                                                                         \
+    struct aws_huffman_symbol_coder *name##_get_coder(void);                                                           \
+    int name##_encode(                                                                                                 \
+        struct aws_huffman_encoder *encoder, struct aws_byte_cursor *to_encode, struct aws_byte_buf *output);          \
+    int name##_decode(                                                                                                 \
+        struct aws_huffman_decoder *decoder, struct aws_byte_cursor *to_decode, struct aws_byte_buf *output)
+
+/**
+ * Defines name_encode and name_decode, which behave exactly like aws_huffman_encode and aws_huffman_decode for
+ * encoders and decoders initialized with name_get_coder(), but read packed_codes and call decode_buffer directly
+ * instead of through the coder's function pointers, so the compiler can inline the tables into the loops.
+ *
+ * The generator expands this at the end of every coder it writes. It must be expanded in the same translation unit as
+ * its arguments:
+ * \param name          The prefix of the functions to define, the same as the coder's name_get_coder
+ * \param packed_codes  The coder's 256 entry packed_codes table, see aws_huffman_symbol_coder
+ * \param decode_buffer The coder's decode_buffer function, see aws_huffman_decode_buffer_fn
+ *
+ * Symbols without a packed code (32 bit codes) are encoded through the coder's encode without leaving the loop.
+ * Encoding stops at the first symbol without any code and leaves the rest, as well as the last few bytes of output,
+ * to aws_huffman_encode. Encoders and decoders with stats or a sampler attached always go through
+ * aws_huffman_encode and aws_huffman_decode, so they're still counted.
+ */
+#define AWS_HUFFMAN_DEFINE_STATIC_CODER(name, packed_codes, decode_buffer)                                             \
+    int name##_encode(                                                                                                 \
+        struct aws_huffman_encoder *encoder, struct aws_byte_cursor *to_encode, struct aws_byte_buf *output) {         \
+                                                                                                                       \
+        AWS_ASSERT(encoder);                                                                                           \
+        AWS_ASSERT(encoder->coder == name##_get_coder());                                                              \
+        AWS_ASSERT(to_encode);                                                                                         \
+        AWS_ASSERT(output);                                                                                            \
+                                                                                                                       \
+        if (encoder->stats || encoder->sampler) {                                                                      \
+            return aws_huffman_encode(encoder, to_encode, output);                                                     \
+        }                                                                                                              \
+                                                                                                                       \
+        uint64_t working_bits = encoder->overflow_bits.pattern;                                                        \
+        uint8_t num_bits = encoder->overflow_bits.num_bits;                                                            \
+        const uint8_t *input = to_encode->ptr;                                                                         \
+        const uint8_t *input_end = to_encode->ptr + to_encode->len;                                                    \
+        uint8_t *out = output->buffer + output->len;                                                                   \
+        uint8_t *out_end = output->buffer + output->capacity;                                                          \
+                                                                                                                       \
+        /* Pack codes into a 64 bit accumulator and write them out 32 bits at a time while there's room */             \
+        while (input != input_end && out_end - out >= (ptrdiff_t)sizeof(uint32_t)) {                                   \
+            const uint32_t packed = (packed_codes)[*input];                                                            \
+            struct aws_huffman_code code;                                                                              \
+            if (packed) {                                                                                              \
+                code.num_bits = AWS_HUFFMAN_PACKED_NUM_BITS(packed);                                                   \
+                code.pattern = AWS_HUFFMAN_PACKED_PATTERN(packed, code.num_bits);                                      \
+            } else {                                                                                                   \
+                code = encoder->coder->encode(*input, encoder->coder->userdata);                                       \
+                if (code.num_bits == 0) {                                                                              \
+                    break;                                                                                             \
+                }                                                                                                      \
+            }                                                                                                          \
+            ++input;                                                                                                   \
+                                                                                                                       \
+            /* num_bits is under 32 here, so even a 32 bit code fits in the accumulator */                             \
+            working_bits = (working_bits << code.num_bits) | code.pattern;                                             \
+            num_bits += code.num_bits;                                                                                 \
+                                                                                                                       \
+            if (num_bits >= 32) {                                                                                      \
+                num_bits -= 32;                                                                                        \
+                const uint32_t word = aws_hton32((uint32_t)(working_bits >> num_bits));                                \
+                memcpy(out, &word, sizeof(word));                                                                      \
+                out += sizeof(word);                                                                                   \
+            }                                                                                                          \
+        }                                                                                                              \
+                                                                                                                       \
+        /* Hand the bits still in the accumulator and the rest of the input to the generic encoder */                  \
+        encoder->overflow_bits.pattern = (uint32_t)(working_bits & ((UINT64_C(1) << num_bits) - 1));                   \
+        encoder->overflow_bits.num_bits = num_bits;                                                                    \
+        aws_byte_cursor_advance(to_encode, (size_t)(input - to_encode->ptr));                                          \
+        output->len = (size_t)(out - output->buffer);                                                                  \
+                                                                                                                       \
+        /* Everything fit exactly, so there's nothing for aws_huffman_encode to do (and the output may be full) */     \
+        if (input == input_end && num_bits == 0) {                                                                     \
+            return AWS_OP_SUCCESS;                                                                                     \
+        }                                                                                                              \
+                                                                                                                       \
+        return aws_huffman_encode(encoder, to_encode, output);                                                         \
+    }                                                                                                                  \
+                                                                                                                       \
+    int name##_decode(                                                                                                 \
+        struct aws_huffman_decoder *decoder, struct aws_byte_cursor *to_decode, struct aws_byte_buf *output) {         \
+                                                                                                                       \
+        AWS_ASSERT(decoder);                                                                                           \
+        AWS_ASSERT(decoder->coder == name##_get_coder());                                                              \
+        AWS_ASSERT(to_decode);                                                                                         \
+        AWS_ASSERT(output);                                                                                            \
+                                                                                                                       \
+        if (decoder->stats) {                                                                                          \
+            return aws_huffman_decode(decoder, to_decode, output);                                                     \
+        }                                                                                                              \
+                                                                                                                       \
+        if (output->len == output->capacity) {                                                                         \
+            return aws_raise_error(AWS_ERROR_SHORT_BUFFER);                                                            \
+        }                                                                                                              \
+                                                                                                                       \
+        const enum aws_huffman_status status = decode_buffer(decoder, to_decode, output, NULL);                        \
+        if (status == AWS_HUFFMAN_NEED_OUTPUT) {                                                                       \
+            return aws_raise_error(AWS_ERROR_SHORT_BUFFER);                                                            \
+        }                                                                                                              \
+        return status == AWS_HUFFMAN_ERROR ? AWS_OP_ERR : AWS_OP_SUCCESS;                                              \
+    }
+
+#endif /* AWS_COMPRESSION_HUFFMAN_STATIC_CODER_H */
@@ -0,0 +1,48 @@
+#ifndef AWS_COMPRESSION_PRIVATE_HUFFMAN_KERNELS_H
+#define AWS_COMPRESSION_PRIVATE_HUFFMAN_KERNELS_H
+
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/compression/private/huffman_length.h>
+
+/**
+ * Adds the number of times each byte value appears in input to counts
+ */
+typedef void(aws_huffman_count_symbols_fn)(uint64_t *counts, const uint8_t *input, size_t len);
+
+typedef size_t(aws_huffman_sum_code_lengths_fn)(const uint8_t *code_lengths, const uint8_t *input, size_t len);
+
+/**
+ * The kernels for one CPU feature level. Every set gives exactly the same
+ * results, so which one runs only changes speed.
+ */
+struct aws_huffman_kernels {
+    /** Name reported by aws_huffman_get_kernels_name */
+    const char *name;
+    aws_huffman_sum_code_lengths_fn *sum_code_lengths;
+    aws_huffman_count_symbols_fn *count_symbols;
+};
+
+void aws_huffman_count_symbols_scalar(uint64_t *counts, const uint8_t *input, size_t len);
+
+/**
+ * Returns the kernels for this CPU, choosing them on first use. The choice can
+ * be forced to the scalar kernels with aws_huffman_force_scalar_kernels or the
+ * AWS_COMPRESSION_FORCE_SCALAR environment variable.
+ */
+const struct aws_huffman_kernels *aws_huffman_get_kernels(void);
+
+#endif /* AWS_COMPRESSION_PRIVATE_HUFFMAN_KERNELS_H */
@@ -0,0 +1,35 @@
+#ifndef AWS_COMPRESSION_PRIVATE_HUFFMAN_LENGTH_H
+#define AWS_COMPRESSION_PRIVATE_HUFFMAN_LENGTH_H
+
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/compression/exports.h>
+
+#include <aws/common/common.h>
+
+/**
+ * Kernels that sum code_lengths[input[i]] over a buffer, in bits.
+ * The AVX2 kernel is only built when the compiler supports it, and must only
+ * be called when the CPU does too.
+ */
+
+size_t aws_huffman_sum_code_lengths_scalar(const uint8_t *code_lengths, const uint8_t *input, size_t len);
+
+#ifdef AWS_COMPRESSION_HAVE_INTEL_SIMD
+size_t aws_huffman_sum_code_lengths_avx2(const uint8_t *code_lengths, const uint8_t *input, size_t len);
+#endif
+
+#endif /* AWS_COMPRESSION_PRIVATE_HUFFMAN_LENGTH_H */
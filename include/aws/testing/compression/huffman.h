@@ -108,6 +108,30 @@ int huffman_test_transitive_chunked(
     size_t output_chunk_size,
     const char **error_string);
 
+/**
+ * Same as huffman_test_transitive_chunked, but with the status returning API
+ * (aws_huffman_encode_step and aws_huffman_decode_step), also checking that
+ * running out of output doesn't raise an error
+ *
+ * \param[in]   coder               The symbol coder to test
+ * \param[in]   input               The buffer to test
+ * \param[in]   size                The size of input
+ * \param[in]   encoded_size        The length of the encoded buffer. Pass 0 to skip check.
+ * \param[in]   output_chunk_size   The amount of output to write at once
+ * \param[out]  error_string        In case of failure, the error string to
+ * report
+ *
+ * \return AWS_OP_SUCCESS on success, AWS_OP_FAILURE on failure (error_string
+ * will be set)
+ */
+int huffman_test_transitive_chunked_step(
+    struct aws_huffman_symbol_coder *coder,
+    const char *input,
+    size_t size,
+    size_t encoded_size,
+    size_t output_chunk_size,
+    const char **error_string);
+
 #include <aws/testing/compression/huffman.inl>
 
 #endif /* AWS_TESTING_COMPRESSION_HUFFMAN_H */
@@ -0,0 +1,67 @@
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/compression/private/huffman_length.h>
+
+#include <immintrin.h>
+
+size_t aws_huffman_sum_code_lengths_avx2(const uint8_t *code_lengths, const uint8_t *input, size_t len) {
+
+    /*
+     * vpshufb only looks up 16 entries (per 128 bit lane), so the table is
+     * split into 16 rows, each stored xor'd with the row before it. Stepping
+     * the index down by 16 (with saturation) per row makes every row past the
+     * byte's own look up 0, so xoring all the lookups together leaves exactly
+     * the byte's entry. Bytes >= 0x80 are negative from the start, so rows 8-15
+     * are a second chain indexed with the top bit flipped.
+     */
+    __m256i rows[16];
+    __m128i previous = _mm_setzero_si128();
+    for (size_t i = 0; i < 16; ++i) {
+        if (i == 8) {
+            previous = _mm_setzero_si128();
+        }
+        const __m128i row = _mm_loadu_si128((const __m128i *)(code_lengths + i * 16));
+        rows[i] = _mm256_broadcastsi128_si256(_mm_xor_si128(row, previous));
+        previous = row;
+    }
+
+    const __m256i step = _mm256_set1_epi8(16);
+    const __m256i top_bit = _mm256_set1_epi8((char)0x80);
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i sums = _mm256_setzero_si256();
+
+    size_t i = 0;
+    for (; i + sizeof(__m256i) <= len; i += sizeof(__m256i)) {
+        __m256i low_index = _mm256_loadu_si256((const __m256i *)(input + i));
+        __m256i high_index = _mm256_xor_si256(low_index, top_bit);
+        __m256i lengths = zero;
+
+        for (size_t row = 0; row < 8; ++row) {
+            lengths = _mm256_xor_si256(lengths, _mm256_shuffle_epi8(rows[row], low_index));
+            lengths = _mm256_xor_si256(lengths, _mm256_shuffle_epi8(rows[row + 8], high_index));
+            low_index = _mm256_subs_epi8(low_index, step);
+            high_index = _mm256_subs_epi8(high_index, step);
+        }
+
+        sums = _mm256_add_epi64(sums, _mm256_sad_epu8(lengths, zero));
+    }
+
+    uint64_t lanes[4];
+    _mm256_storeu_si256((__m256i *)lanes, sums);
+
+    return (size_t)(lanes[0] + lanes[1] + lanes[2] + lanes[3]) +
+           aws_huffman_sum_code_lengths_scalar(code_lengths, input + i, len - i);
+}
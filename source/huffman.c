@@ -16,8 +16,11 @@
 #include <aws/compression/huffman.h>
 
 #include <aws/compression/error.h>
+#include <aws/compression/private/huffman_kernels.h>
 
+#include <aws/common/atomics.h>
 #include <aws/common/byte_buf.h>
+#include <aws/common/math.h>
 
 #define BITSIZEOF(val) (sizeof(val) * 8)
 
@@ -37,9 +40,8 @@ void aws_huffman_encoder_reset(struct aws_huffman_encoder *encoder) {
 
     AWS_ASSERT(encoder);
 
-    uint8_t eos_padding = encoder->eos_padding;
-    aws_huffman_encoder_init(encoder, encoder->coder);
-    encoder->eos_padding = eos_padding;
+    /* Only overflow_bits belongs to the stream. The params and probed code lengths are kept */
+    AWS_ZERO_STRUCT(encoder->overflow_bits);
 }
 
 void aws_huffman_decoder_init(struct aws_huffman_decoder *decoder, struct aws_huffman_symbol_coder *coder) {
@@ -53,7 +55,79 @@ void aws_huffman_decoder_init(struct aws_huffman_decoder *decoder, struct aws_hu
 
 void aws_huffman_decoder_reset(struct aws_huffman_decoder *decoder) {
 
+    struct aws_huffman_stats *stats = decoder->stats;
     aws_huffman_decoder_init(decoder, decoder->coder);
+    decoder->stats = stats;
+}
+
+void aws_huffman_stats_init(struct aws_huffman_stats *stats) {
+
+    AWS_PRECONDITION(stats);
+
+    aws_atomic_init_int(&stats->num_calls, 0);
+    aws_atomic_init_int(&stats->num_symbols, 0);
+    aws_atomic_init_int(&stats->num_bytes_in, 0);
+    aws_atomic_init_int(&stats->num_bytes_out, 0);
+    aws_atomic_init_int(&stats->num_short_buffer, 0);
+    aws_atomic_init_int(&stats->num_carries, 0);
+    aws_atomic_init_int(&stats->num_pending_bits, 0);
+}
+
+static size_t s_stats_read(const struct aws_atomic_var *counter) {
+    return aws_atomic_load_int_explicit(counter, aws_memory_order_relaxed);
+}
+
+void aws_huffman_stats_snapshot(const struct aws_huffman_stats *stats, struct aws_huffman_stats_snapshot *snapshot) {
+
+    AWS_PRECONDITION(stats);
+    AWS_PRECONDITION(snapshot);
+
+    snapshot->num_calls = s_stats_read(&stats->num_calls);
+    snapshot->num_symbols = s_stats_read(&stats->num_symbols);
+    snapshot->num_bytes_in = s_stats_read(&stats->num_bytes_in);
+    snapshot->num_bytes_out = s_stats_read(&stats->num_bytes_out);
+    snapshot->num_short_buffer = s_stats_read(&stats->num_short_buffer);
+    snapshot->num_carries = s_stats_read(&stats->num_carries);
+    snapshot->num_pending_bits = s_stats_read(&stats->num_pending_bits);
+}
+
+/* Only the owning thread writes, so a relaxed load and store is enough and avoids a locked add */
+static void s_stats_add(struct aws_atomic_var *counter, size_t value) {
+    aws_atomic_store_int_explicit(
+        counter, aws_atomic_load_int_explicit(counter, aws_memory_order_relaxed) + value, aws_memory_order_relaxed);
+}
+
+static void s_stats_record(
+    struct aws_huffman_stats *stats,
+    enum aws_huffman_status status,
+    size_t num_symbols,
+    size_t num_bytes_in,
+    size_t num_bytes_out,
+    uint8_t pending_bits) {
+
+    s_stats_add(&stats->num_calls, 1);
+    s_stats_add(&stats->num_symbols, num_symbols);
+    s_stats_add(&stats->num_bytes_in, num_bytes_in);
+    s_stats_add(&stats->num_bytes_out, num_bytes_out);
+    if (status == AWS_HUFFMAN_NEED_OUTPUT) {
+        s_stats_add(&stats->num_short_buffer, 1);
+    }
+    if (pending_bits) {
+        s_stats_add(&stats->num_carries, 1);
+        s_stats_add(&stats->num_pending_bits, pending_bits);
+    }
+}
+
+/* For the int returning API, running out of output space is an error */
+static int s_status_to_result(enum aws_huffman_status status) {
+    switch (status) {
+        case AWS_HUFFMAN_NEED_OUTPUT:
+            return aws_raise_error(AWS_ERROR_SHORT_BUFFER);
+        case AWS_HUFFMAN_ERROR:
+            return AWS_OP_ERR;
+        default:
+            return AWS_OP_SUCCESS;
+    }
 }
 
 /* Much of encode is written in a helper function,
@@ -66,15 +140,29 @@ struct encoder_state {
 };
 
 /* Helper function to write a single bit_pattern to memory (or working_bits if
- * out of buffer space) */
-static int encode_write_bit_pattern(struct encoder_state *state, struct aws_huffman_code bit_pattern) {
+ * out of buffer space). Returns AWS_HUFFMAN_DONE once the whole pattern is written */
+static enum aws_huffman_status encode_write_bit_pattern(
+    struct encoder_state *state,
+    struct aws_huffman_code bit_pattern) {
 
     if (bit_pattern.num_bits == 0) {
-        return aws_raise_error(AWS_ERROR_COMPRESSION_UNKNOWN_SYMBOL);
+        aws_raise_error(AWS_ERROR_COMPRESSION_UNKNOWN_SYMBOL);
+        return AWS_HUFFMAN_ERROR;
     }
 
     uint8_t bits_to_write = bit_pattern.num_bits;
     while (bits_to_write > 0) {
+        if (state->bit_pos == 8 && state->output_buf->len == state->output_buf->capacity) {
+            /* No room to start a new byte, write all the remaining bits to overflow_bits and return */
+            uint8_t bits_to_cut = BITSIZEOF(bit_pattern.pattern) - bits_to_write;
+
+            state->encoder->overflow_bits.num_bits = bits_to_write;
+            state->encoder->overflow_bits.pattern =
+                (bit_pattern.pattern << bits_to_cut) >> (MAX_PATTERN_BITS - bits_to_write);
+
+            return AWS_HUFFMAN_NEED_OUTPUT;
+        }
+
         uint8_t bits_for_current = bits_to_write > state->bit_pos ? state->bit_pos : bits_to_write;
         /* Chop off the top 0s and bits that have already been read */
         uint8_t bits_to_cut =
@@ -94,40 +182,79 @@ static int encode_write_bit_pattern(struct encoder_state *state, struct aws_huff
 
             state->bit_pos = 8;
             state->working = 0;
+        }
+    }
 
-            if (state->output_buf->len == state->output_buf->capacity) {
-                /* Write all the remaining bits to working_bits and return */
+    return AWS_HUFFMAN_DONE;
+}
 
-                bits_to_cut += bits_for_current;
+size_t aws_huffman_sum_code_lengths_scalar(const uint8_t *code_lengths, const uint8_t *input, size_t len) {
 
-                state->encoder->overflow_bits.num_bits = bits_to_write;
-                if (bits_to_write) {
-                    state->encoder->overflow_bits.pattern =
-                        (bit_pattern.pattern << bits_to_cut) >> (MAX_PATTERN_BITS - bits_to_write);
-                }
+    size_t num_bits = 0;
+    for (size_t i = 0; i < len; ++i) {
+        num_bits += code_lengths[input[i]];
+    }
+    return num_bits;
+}
 
-                return aws_raise_error(AWS_ERROR_SHORT_BUFFER);
-            }
-        }
+/* Looks symbol up in packed_codes when it has an entry, calling back to the coder otherwise */
+static struct aws_huffman_code s_encode_symbol(
+    const struct aws_huffman_symbol_coder *coder,
+    const uint32_t *packed_codes,
+    uint8_t symbol) {
+
+    if (packed_codes && packed_codes[symbol]) {
+        struct aws_huffman_code code_point;
+        code_point.num_bits = AWS_HUFFMAN_PACKED_NUM_BITS(packed_codes[symbol]);
+        code_point.pattern = AWS_HUFFMAN_PACKED_PATTERN(packed_codes[symbol], code_point.num_bits);
+        return code_point;
     }
 
-    return AWS_OP_SUCCESS;
+    return coder->encode(symbol, coder->userdata);
 }
 
-size_t aws_huffman_get_encoded_length(struct aws_huffman_encoder *encoder, struct aws_byte_cursor to_encode) {
-
-    AWS_PRECONDITION(encoder);
-    AWS_PRECONDITION(to_encode.ptr && to_encode.len);
+/* Returns the number of bits encoding to_encode takes, not counting any bits held by the encoder */
+static size_t s_get_encoded_bits(struct aws_huffman_encoder *encoder, struct aws_byte_cursor to_encode) {
 
     size_t num_bits = 0;
 
+    const uint8_t *code_lengths = encoder->coder->code_lengths;
+
+    if (!code_lengths && encoder->probed_coder != encoder->coder &&
+        to_encode.len > AWS_ARRAY_SIZE(encoder->probed_code_lengths)) {
+        /* Probing every symbol once is cheaper than calling back for every byte, and the encoder keeps the result */
+        for (size_t i = 0; i < AWS_ARRAY_SIZE(encoder->probed_code_lengths); ++i) {
+            encoder->probed_code_lengths[i] =
+                s_encode_symbol(encoder->coder, encoder->coder->packed_codes, (uint8_t)i).num_bits;
+        }
+        encoder->probed_coder = encoder->coder;
+    }
+    if (!code_lengths && encoder->probed_coder == encoder->coder) {
+        code_lengths = encoder->probed_code_lengths;
+    }
+
+    if (code_lengths) {
+        num_bits = aws_huffman_get_kernels()->sum_code_lengths(code_lengths, to_encode.ptr, to_encode.len);
+        to_encode.len = 0;
+    }
+
     while (to_encode.len) {
         uint8_t new_byte = 0;
         aws_byte_cursor_read_u8(&to_encode, &new_byte);
-        struct aws_huffman_code code_point = encoder->coder->encode(new_byte, encoder->coder->userdata);
+        struct aws_huffman_code code_point = s_encode_symbol(encoder->coder, encoder->coder->packed_codes, new_byte);
         num_bits += code_point.num_bits;
     }
 
+    return num_bits;
+}
+
+size_t aws_huffman_get_encoded_length(struct aws_huffman_encoder *encoder, struct aws_byte_cursor to_encode) {
+
+    AWS_PRECONDITION(encoder);
+    AWS_PRECONDITION(to_encode.ptr && to_encode.len);
+
+    const size_t num_bits = s_get_encoded_bits(encoder, to_encode);
+
     size_t length = num_bits / 8;
 
     /* Round up */
@@ -140,24 +267,21 @@ size_t aws_huffman_get_encoded_length(struct aws_huffman_encoder *encoder, struc
 
 #define CHECK_WRITE_BITS(bit_pattern)                                                                                  \
     do {                                                                                                               \
-        int result = encode_write_bit_pattern(&state, bit_pattern);                                                    \
-        if (result != AWS_OP_SUCCESS) {                                                                                \
-            return result;                                                                                             \
+        enum aws_huffman_status status = encode_write_bit_pattern(&state, bit_pattern);                                \
+        if (status != AWS_HUFFMAN_DONE) {                                                                              \
+            return status;                                                                                             \
         }                                                                                                              \
     } while (0)
 
-int aws_huffman_encode(
+/* Encodes to_encode, then pads to a whole byte if finish is set, or keeps the partial byte in overflow_bits if not */
+static enum aws_huffman_status s_encode(
     struct aws_huffman_encoder *encoder,
     struct aws_byte_cursor *to_encode,
-    struct aws_byte_buf *output) {
-
-    AWS_ASSERT(encoder);
-    AWS_ASSERT(encoder->coder);
-    AWS_ASSERT(to_encode);
-    AWS_ASSERT(output);
+    struct aws_byte_buf *output,
+    bool finish) {
 
     if (output->len == output->capacity) {
-        return aws_raise_error(AWS_ERROR_SHORT_BUFFER);
+        return AWS_HUFFMAN_NEED_OUTPUT;
     }
 
     struct encoder_state state = {
@@ -167,22 +291,60 @@ int aws_huffman_encode(
     state.encoder = encoder;
     state.output_buf = output;
 
-    /* Write any bits leftover from previous invocation */
-    if (encoder->overflow_bits.num_bits) {
-        CHECK_WRITE_BITS(encoder->overflow_bits);
-        AWS_ZERO_STRUCT(encoder->overflow_bits);
+    /* Pick up any bits leftover from previous invocation */
+    uint64_t working_bits = encoder->overflow_bits.pattern;
+    uint8_t num_bits = encoder->overflow_bits.num_bits;
+    AWS_ZERO_STRUCT(encoder->overflow_bits);
+
+    const uint32_t *packed_codes = encoder->coder->packed_codes;
+
+    /* While there's room, pack codes into a 64 bit accumulator and write them out 32 bits at a time */
+    while (to_encode->len && output->capacity - output->len >= sizeof(uint32_t)) {
+        uint8_t new_byte = 0;
+        aws_byte_cursor_read_u8(to_encode, &new_byte);
+        struct aws_huffman_code code_point = s_encode_symbol(encoder->coder, packed_codes, new_byte);
+
+        if (code_point.num_bits == 0) {
+            aws_raise_error(AWS_ERROR_COMPRESSION_UNKNOWN_SYMBOL);
+            return AWS_HUFFMAN_ERROR;
+        }
+
+        /* num_bits is always < 32 here, so a code of up to 32 bits always fits */
+        working_bits = (working_bits << code_point.num_bits) | code_point.pattern;
+        num_bits += code_point.num_bits;
+
+        if (num_bits >= 32) {
+            num_bits -= 32;
+            aws_byte_buf_write_be32(output, (uint32_t)(working_bits >> num_bits));
+        }
     }
 
+    /* Hand anything left in the accumulator to the byte at a time path */
+    if (num_bits) {
+        struct aws_huffman_code leftover;
+        leftover.pattern = (uint32_t)working_bits & (UINT32_MAX >> (MAX_PATTERN_BITS - num_bits));
+        leftover.num_bits = num_bits;
+        CHECK_WRITE_BITS(leftover);
+    }
+
+    /* Near the end of the output buffer, write one byte at a time */
     while (to_encode->len) {
         uint8_t new_byte = 0;
         aws_byte_cursor_read_u8(to_encode, &new_byte);
-        struct aws_huffman_code code_point = encoder->coder->encode(new_byte, encoder->coder->userdata);
+        struct aws_huffman_code code_point = s_encode_symbol(encoder->coder, packed_codes, new_byte);
 
         CHECK_WRITE_BITS(code_point);
     }
 
     /* The following code only runs when the buffer has written successfully */
 
+    if (!finish) {
+        /* More input is coming, carry the partial byte over to the next call */
+        encoder->overflow_bits.pattern = state.working >> state.bit_pos;
+        encoder->overflow_bits.num_bits = 8 - state.bit_pos;
+        return AWS_HUFFMAN_NEED_INPUT;
+    }
+
     /* If whole buffer processed, write EOS */
     if (state.bit_pos != 8) {
         struct aws_huffman_code eos_cp;
@@ -192,22 +354,236 @@ int aws_huffman_encode(
         AWS_ASSERT(state.bit_pos == 8);
     }
 
-    return AWS_OP_SUCCESS;
+    return AWS_HUFFMAN_DONE;
 }
 
 #undef CHECK_WRITE_BITS
 
+/* Runs s_encode, counting the call if the encoder has stats or a sampler */
+static enum aws_huffman_status s_encode_counted(
+    struct aws_huffman_encoder *encoder,
+    struct aws_byte_cursor *to_encode,
+    struct aws_byte_buf *output,
+    bool finish) {
+
+    if (!encoder->stats && !encoder->sampler) {
+        return s_encode(encoder, to_encode, output, finish);
+    }
+
+    const struct aws_byte_cursor input = *to_encode;
+    const size_t output_len = output->len;
+
+    enum aws_huffman_status status = s_encode(encoder, to_encode, output, finish);
+
+    const size_t num_symbols = input.len - to_encode->len;
+    if (encoder->stats) {
+        s_stats_record(
+            encoder->stats,
+            status,
+            num_symbols,
+            num_symbols,
+            output->len - output_len,
+            encoder->overflow_bits.num_bits);
+    }
+    if (encoder->sampler) {
+        aws_huffman_sampler_sample(encoder->sampler, aws_byte_cursor_from_array(input.ptr, num_symbols));
+    }
+
+    return status;
+}
+
+int aws_huffman_encode(
+    struct aws_huffman_encoder *encoder,
+    struct aws_byte_cursor *to_encode,
+    struct aws_byte_buf *output) {
+
+    AWS_ASSERT(encoder);
+    AWS_ASSERT(encoder->coder);
+    AWS_ASSERT(to_encode);
+    AWS_ASSERT(output);
+
+    return s_status_to_result(s_encode_counted(encoder, to_encode, output, true));
+}
+
+int aws_huffman_encode_update(
+    struct aws_huffman_encoder *encoder,
+    struct aws_byte_cursor *to_encode,
+    struct aws_byte_buf *output) {
+
+    AWS_ASSERT(encoder);
+    AWS_ASSERT(encoder->coder);
+    AWS_ASSERT(to_encode);
+    AWS_ASSERT(output);
+
+    return s_status_to_result(s_encode_counted(encoder, to_encode, output, false));
+}
+
+int aws_huffman_encode_finish(struct aws_huffman_encoder *encoder, struct aws_byte_buf *output) {
+
+    AWS_ASSERT(encoder);
+    AWS_ASSERT(encoder->coder);
+    AWS_ASSERT(output);
+
+    if (encoder->overflow_bits.num_bits == 0) {
+        /* Ended on a byte boundary, nothing to pad */
+        return AWS_OP_SUCCESS;
+    }
+
+    struct aws_byte_cursor to_encode;
+    AWS_ZERO_STRUCT(to_encode);
+    return s_status_to_result(s_encode_counted(encoder, &to_encode, output, true));
+}
+
+enum aws_huffman_status aws_huffman_encode_step(
+    struct aws_huffman_encoder *encoder,
+    struct aws_byte_cursor *to_encode,
+    struct aws_byte_buf *output,
+    bool finish) {
+
+    AWS_ASSERT(encoder);
+    AWS_ASSERT(encoder->coder);
+    AWS_ASSERT(to_encode);
+    AWS_ASSERT(output);
+
+    return s_encode_counted(encoder, to_encode, output, finish);
+}
+
+int aws_huffman_encode_dynamic(
+    struct aws_huffman_encoder *encoder,
+    struct aws_byte_cursor *to_encode,
+    struct aws_byte_buf *output) {
+
+    AWS_ASSERT(encoder);
+    AWS_ASSERT(encoder->coder);
+    AWS_ASSERT(to_encode);
+    AWS_ASSERT(output);
+
+    /* The exact size, including bits left from an earlier call */
+    const size_t num_bits = encoder->overflow_bits.num_bits + s_get_encoded_bits(encoder, *to_encode);
+    size_t length = num_bits / 8 + (num_bits % 8 != 0);
+    if (to_encode->len == 0 && encoder->overflow_bits.num_bits == 0) {
+        return AWS_OP_SUCCESS;
+    }
+
+    if (length == 0) {
+        /* Every symbol is missing a code. Leave room for aws_huffman_encode to get as far as reporting it */
+        length = 1;
+    }
+
+    size_t required_capacity = 0;
+    if (aws_add_size_checked(output->len, length, &required_capacity) ||
+        aws_byte_buf_reserve(output, required_capacity)) {
+        return AWS_OP_ERR;
+    }
+
+    return aws_huffman_encode(encoder, to_encode, output);
+}
+
+int aws_huffman_encode_in_place(struct aws_huffman_encoder *encoder, struct aws_byte_buf *buf) {
+
+    AWS_ASSERT(encoder);
+    AWS_ASSERT(encoder->coder);
+    AWS_ASSERT(buf);
+
+    const struct aws_huffman_symbol_coder *coder = encoder->coder;
+
+    /* Check every prefix first, so the buffer is left untouched if encoding can't be done in place.
+       Once symbol i is read, the bytes written so far must all be at or before i */
+    enum aws_huffman_status status = AWS_HUFFMAN_DONE;
+    size_t num_bits = encoder->overflow_bits.num_bits;
+    for (size_t i = 0; i < buf->len; ++i) {
+        const uint8_t symbol = buf->buffer[i];
+        const uint8_t code_length = coder->code_lengths ? coder->code_lengths[symbol]
+                                                        : s_encode_symbol(coder, coder->packed_codes, symbol).num_bits;
+        if (code_length == 0) {
+            aws_raise_error(AWS_ERROR_COMPRESSION_UNKNOWN_SYMBOL);
+            status = AWS_HUFFMAN_ERROR;
+            break;
+        }
+
+        num_bits += code_length;
+        if (num_bits / 8 > i + 1) {
+            status = AWS_HUFFMAN_NEED_OUTPUT;
+            break;
+        }
+    }
+    if (status == AWS_HUFFMAN_DONE && num_bits / 8 + (num_bits % 8 != 0) > buf->len) {
+        status = AWS_HUFFMAN_NEED_OUTPUT;
+    }
+
+    if (status != AWS_HUFFMAN_DONE) {
+        /* Nothing was read or written, but the call still counts */
+        if (encoder->stats) {
+            s_stats_record(encoder->stats, status, 0, 0, 0, encoder->overflow_bits.num_bits);
+        }
+        return s_status_to_result(status);
+    }
+
+    if (encoder->sampler) {
+        aws_huffman_sampler_sample(encoder->sampler, aws_byte_cursor_from_buf(buf));
+    }
+
+    uint64_t working_bits = encoder->overflow_bits.pattern;
+    uint8_t pending_bits = encoder->overflow_bits.num_bits;
+    AWS_ZERO_STRUCT(encoder->overflow_bits);
+
+    size_t write_pos = 0;
+    for (size_t read_pos = 0; read_pos < buf->len; ++read_pos) {
+        struct aws_huffman_code code_point = s_encode_symbol(coder, coder->packed_codes, buf->buffer[read_pos]);
+
+        /* At most 32 bits are ever pending here, so a code of up to 32 bits always fits */
+        working_bits = (working_bits << code_point.num_bits) | code_point.pattern;
+        pending_bits += code_point.num_bits;
+
+        while (pending_bits >= 8) {
+            pending_bits -= 8;
+            buf->buffer[write_pos++] = (uint8_t)(working_bits >> pending_bits);
+        }
+    }
+
+    /* Pad the last byte with the low bits of eos_padding, as encode_write_bit_pattern does */
+    if (pending_bits) {
+        const uint8_t padding_bits = 8 - pending_bits;
+        buf->buffer[write_pos++] =
+            (uint8_t)((working_bits << padding_bits) | (encoder->eos_padding & (UINT8_MAX >> pending_bits)));
+    }
+
+    if (encoder->stats) {
+        s_stats_record(encoder->stats, AWS_HUFFMAN_DONE, buf->len, buf->len, write_pos, 0);
+    }
+
+    buf->len = write_pos;
+    return AWS_OP_SUCCESS;
+}
+
 /* Decode's reading is written in a helper function,
    so this struct helps avoid passing all the parameters through by hand */
 struct decoder_state {
     struct aws_huffman_decoder *decoder;
     struct aws_byte_cursor *input_cursor;
+    /* The number of bits needed to be sure a whole code is in working_bits */
+    uint8_t max_code_length;
 };
 
 static void decode_fill_working_bits(struct decoder_state *state) {
 
-    /* Read from bytes in the buffer until there are enough bytes to process */
-    while (state->decoder->num_bits < MAX_PATTERN_BITS && state->input_cursor->len) {
+    if (state->decoder->num_bits < state->max_code_length && state->input_cursor->len >= sizeof(uint64_t)) {
+        /* Top up with a single unaligned big-endian load, keeping as many whole bytes as fit */
+        const uint8_t num_bytes = (BITSIZEOF(state->decoder->working_bits) - 1 - state->decoder->num_bits) / 8;
+
+        struct aws_byte_cursor peek = *state->input_cursor;
+        uint64_t new_bits = 0;
+        aws_byte_cursor_read_be64(&peek, &new_bits);
+        new_bits &= UINT64_MAX << (BITSIZEOF(new_bits) - num_bytes * 8);
+
+        state->decoder->working_bits |= new_bits >> state->decoder->num_bits;
+        state->decoder->num_bits += num_bytes * 8;
+        aws_byte_cursor_advance(state->input_cursor, num_bytes);
+        return;
+    }
+
+    /* Read the tail of the buffer one byte at a time until there are enough bits to process */
+    while (state->decoder->num_bits < state->max_code_length && state->input_cursor->len) {
 
         /* Read the appropiate number of bits from this byte */
         uint8_t new_byte = 0;
@@ -221,23 +597,17 @@ static void decode_fill_working_bits(struct decoder_state *state) {
     }
 }
 
-int aws_huffman_decode(
+/* Runs the generic decode loop. If output is NULL, symbols are only counted into *num_decoded */
+static enum aws_huffman_status s_decode(
     struct aws_huffman_decoder *decoder,
     struct aws_byte_cursor *to_decode,
-    struct aws_byte_buf *output) {
-
-    AWS_ASSERT(decoder);
-    AWS_ASSERT(decoder->coder);
-    AWS_ASSERT(to_decode);
-    AWS_ASSERT(output);
-
-    if (output->len == output->capacity) {
-        return aws_raise_error(AWS_ERROR_SHORT_BUFFER);
-    }
+    struct aws_byte_buf *output,
+    size_t *num_decoded) {
 
     struct decoder_state state;
     state.decoder = decoder;
     state.input_cursor = to_decode;
+    state.max_code_length = decoder->coder->max_code_length ? decoder->coder->max_code_length : MAX_PATTERN_BITS;
 
     /* Measures how much of the input was read */
     size_t bits_left = decoder->num_bits + to_decode->len * 8;
@@ -246,19 +616,36 @@ int aws_huffman_decode(
 
         decode_fill_working_bits(&state);
 
-        uint8_t symbol;
-        uint8_t bits_read = decoder->coder->decode(
-            (uint32_t)(decoder->working_bits >> (BITSIZEOF(decoder->working_bits) - MAX_PATTERN_BITS)),
-            &symbol,
-            decoder->coder->userdata);
+        const uint32_t bits =
+            (uint32_t)(decoder->working_bits >> (BITSIZEOF(decoder->working_bits) - MAX_PATTERN_BITS));
+
+        uint8_t symbols[AWS_HUFFMAN_MAX_DECODE_SYMBOLS];
+        uint8_t num_symbols = 0;
+        uint8_t bits_read = 0;
+
+        if (decoder->coder->decode_multi) {
+            bits_read = decoder->coder->decode_multi(bits, symbols, &num_symbols, decoder->coder->userdata);
+            AWS_ASSERT(num_symbols <= AWS_HUFFMAN_MAX_DECODE_SYMBOLS);
+
+            if (bits_read > decoder->num_bits || (output && num_symbols > output->capacity - output->len)) {
+                /* Not all of the symbols were loaded or fit, fall back to decoding one at a time */
+                bits_read = 0;
+            }
+        }
+
+        if (bits_read == 0) {
+            bits_read = decoder->coder->decode(bits, symbols, decoder->coder->userdata);
+            num_symbols = 1;
+        }
 
         if (bits_read == 0) {
-            if (bits_left < MAX_PATTERN_BITS) {
+            if (bits_left < state.max_code_length) {
                 /* More input is needed to continue */
-                return AWS_OP_SUCCESS;
+                return AWS_HUFFMAN_NEED_INPUT;
             }
             /* Unknown symbol found */
-            return aws_raise_error(AWS_ERROR_COMPRESSION_UNKNOWN_SYMBOL);
+            aws_raise_error(AWS_ERROR_COMPRESSION_UNKNOWN_SYMBOL);
+            return AWS_HUFFMAN_ERROR;
         }
         if (bits_read > bits_left) {
             /* Check if the buffer has been overrun.
@@ -266,27 +653,207 @@ int aws_huffman_decode(
             the buffer won't actually overrun, instead there will
             be 0's in the bottom of working_bits. */
 
-            return AWS_OP_SUCCESS;
+            return AWS_HUFFMAN_NEED_INPUT;
         }
 
-        if (output->len == output->capacity) {
+        if (output && output->len == output->capacity) {
             /* Check if we've hit the end of the output buffer */
-            return aws_raise_error(AWS_ERROR_SHORT_BUFFER);
+            return AWS_HUFFMAN_NEED_OUTPUT;
         }
 
         bits_left -= bits_read;
         decoder->working_bits <<= bits_read;
         decoder->num_bits -= bits_read;
 
-        /* Store the found symbol */
-        aws_byte_buf_write_u8(output, symbol);
+        /* Store the found symbols */
+        if (output) {
+            aws_byte_buf_write(output, symbols, num_symbols);
+        } else {
+            *num_decoded += num_symbols;
+        }
 
         /* Successfully decoded whole buffer */
         if (bits_left == 0) {
-            return AWS_OP_SUCCESS;
+            return AWS_HUFFMAN_NEED_INPUT;
         }
     }
 
     /* This case is unreachable */
     AWS_ASSERT(0);
 }
+
+int aws_huffman_get_decoded_length(
+    struct aws_huffman_decoder *decoder,
+    struct aws_byte_cursor to_decode,
+    size_t *out_length) {
+
+    AWS_PRECONDITION(decoder);
+    AWS_PRECONDITION(decoder->coder);
+    AWS_PRECONDITION(out_length);
+
+    /* Run on a copy, so the caller's decoder is left where it was */
+    struct aws_huffman_decoder scratch = *decoder;
+
+    size_t num_decoded = 0;
+    if (s_decode(&scratch, &to_decode, NULL, &num_decoded) == AWS_HUFFMAN_ERROR) {
+        return AWS_OP_ERR;
+    }
+
+    *out_length = num_decoded;
+    return AWS_OP_SUCCESS;
+}
+
+/* Runs the coder's own decode loop if it has one, which only needs output space once it finds a symbol */
+static enum aws_huffman_status s_decode_loop(
+    struct aws_huffman_decoder *decoder,
+    struct aws_byte_cursor *to_decode,
+    struct aws_byte_buf *output) {
+
+    if (decoder->coder->decode_buffer) {
+        /* The coder provides a specialized loop */
+        return decoder->coder->decode_buffer(decoder, to_decode, output, decoder->coder->userdata);
+    }
+
+    return s_decode(decoder, to_decode, output, NULL);
+}
+
+/* Decodes one contiguous buffer, failing up front if there's no room for output */
+static enum aws_huffman_status s_decode_buffer(
+    struct aws_huffman_decoder *decoder,
+    struct aws_byte_cursor *to_decode,
+    struct aws_byte_buf *output) {
+
+    if (output->len == output->capacity) {
+        return AWS_HUFFMAN_NEED_OUTPUT;
+    }
+
+    return s_decode_loop(decoder, to_decode, output);
+}
+
+/* Runs s_decode_buffer, counting the call if the decoder has stats */
+static enum aws_huffman_status s_decode_counted(
+    struct aws_huffman_decoder *decoder,
+    struct aws_byte_cursor *to_decode,
+    struct aws_byte_buf *output) {
+
+    if (!decoder->stats) {
+        return s_decode_buffer(decoder, to_decode, output);
+    }
+
+    const size_t input_len = to_decode->len;
+    const size_t output_len = output->len;
+
+    enum aws_huffman_status status = s_decode_buffer(decoder, to_decode, output);
+
+    const size_t num_symbols = output->len - output_len;
+    s_stats_record(decoder->stats, status, num_symbols, input_len - to_decode->len, num_symbols, decoder->num_bits);
+
+    return status;
+}
+
+int aws_huffman_decode(
+    struct aws_huffman_decoder *decoder,
+    struct aws_byte_cursor *to_decode,
+    struct aws_byte_buf *output) {
+
+    AWS_ASSERT(decoder);
+    AWS_ASSERT(decoder->coder);
+    AWS_ASSERT(to_decode);
+    AWS_ASSERT(output);
+
+    return s_status_to_result(s_decode_counted(decoder, to_decode, output));
+}
+
+enum aws_huffman_status aws_huffman_decode_step(
+    struct aws_huffman_decoder *decoder,
+    struct aws_byte_cursor *to_decode,
+    struct aws_byte_buf *output) {
+
+    AWS_ASSERT(decoder);
+    AWS_ASSERT(decoder->coder);
+    AWS_ASSERT(to_decode);
+    AWS_ASSERT(output);
+
+    return s_decode_counted(decoder, to_decode, output);
+}
+
+int aws_huffman_decode_cursors(
+    struct aws_huffman_decoder *decoder,
+    struct aws_byte_cursor *to_decode,
+    size_t num_cursors,
+    struct aws_byte_buf *output) {
+
+    AWS_ASSERT(decoder);
+    AWS_ASSERT(decoder->coder);
+    AWS_ASSERT(to_decode || num_cursors == 0);
+    AWS_ASSERT(output);
+
+    const size_t output_len = output->len;
+    size_t num_bytes_in = 0;
+
+    enum aws_huffman_status status = AWS_HUFFMAN_NEED_INPUT;
+    for (size_t i = 0; i < num_cursors; ++i) {
+        const size_t input_len = to_decode[i].len;
+        if (input_len) {
+            /* The bits of a code cut off at the end of a fragment stay in working_bits for the next one */
+            status = s_decode_buffer(decoder, &to_decode[i], output);
+        } else if (i + 1 == num_cursors && decoder->num_bits) {
+            /* After a short buffer, the last fragment's bytes may all be in working_bits already. They may only be
+               padding, so let the loop decide whether a full output buffer is actually short */
+            status = s_decode_loop(decoder, &to_decode[i], output);
+        } else {
+            continue;
+        }
+        num_bytes_in += input_len - to_decode[i].len;
+
+        if (status != AWS_HUFFMAN_NEED_INPUT) {
+            break;
+        }
+    }
+
+    if (decoder->stats) {
+        const size_t num_symbols = output->len - output_len;
+        s_stats_record(decoder->stats, status, num_symbols, num_bytes_in, num_symbols, decoder->num_bits);
+    }
+
+    return s_status_to_result(status);
+}
+
+int aws_huffman_decode_dynamic(
+    struct aws_huffman_decoder *decoder,
+    struct aws_byte_cursor *to_decode,
+    struct aws_byte_buf *output) {
+
+    AWS_ASSERT(decoder);
+    AWS_ASSERT(decoder->coder);
+    AWS_ASSERT(to_decode);
+    AWS_ASSERT(output);
+
+    /* No more symbols than there are shortest codes in the input. Without a
+       known shortest code, every bit could be a symbol */
+    const size_t min_code_length = decoder->coder->min_code_length ? decoder->coder->min_code_length : 1;
+
+    size_t num_bits = 0;
+    size_t required_capacity = 0;
+    if (aws_mul_size_checked(to_decode->len, 8, &num_bits) ||
+        aws_add_size_checked(num_bits, decoder->num_bits, &num_bits)) {
+        return AWS_OP_ERR;
+    }
+
+    if (num_bits == 0) {
+        return AWS_OP_SUCCESS;
+    }
+
+    /* Always leave room for one symbol, as aws_huffman_decode won't start without it */
+    size_t max_length = num_bits / min_code_length;
+    if (max_length == 0) {
+        max_length = 1;
+    }
+
+    if (aws_add_size_checked(output->len, max_length, &required_capacity) ||
+        aws_byte_buf_reserve(output, required_capacity)) {
+        return AWS_OP_ERR;
+    }
+
+    return aws_huffman_decode(decoder, to_decode, output);
+}
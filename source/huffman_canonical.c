@@ -0,0 +1,260 @@
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/compression/huffman.h>
+
+#include <aws/compression/error.h>
+
+#include <string.h>
+
+#define BITSIZEOF(val) (sizeof(val) * 8)
+
+/* Codes up to this long are resolved with a single lookup */
+#define PRIMARY_TABLE_BITS 9
+
+/* Encoders pad the last byte with up to this many bits of eos_padding, all 1s by default */
+#define MAX_PADDING_BITS 7
+
+enum { MAX_CODE_LENGTH = BITSIZEOF(((struct aws_huffman_code *)0)->pattern) };
+
+struct primary_table_entry {
+    uint8_t symbol;
+    /* 0 if no code of PRIMARY_TABLE_BITS or fewer bits matches this prefix */
+    uint8_t num_bits;
+};
+
+struct canonical_coder {
+    struct aws_huffman_symbol_coder coder;
+    struct aws_allocator *allocator;
+
+    struct aws_huffman_code codes[256];
+    uint32_t packed_codes[256];
+    uint8_t code_lengths[256];
+
+    uint8_t primary_bits;
+    struct primary_table_entry primary_table[1 << PRIMARY_TABLE_BITS];
+
+    /*
+     * For codes longer than primary_bits. Codes of each length are consecutive
+     * values starting at first_code[len], and their symbols are consecutive in
+     * sorted_symbols starting at first_index[len].
+     */
+    uint32_t first_code[MAX_CODE_LENGTH + 1];
+    uint16_t count[MAX_CODE_LENGTH + 1];
+    uint16_t first_index[MAX_CODE_LENGTH + 1];
+    uint8_t sorted_symbols[256];
+};
+
+static struct aws_huffman_code s_encode_symbol(uint8_t symbol, void *userdata) {
+
+    struct canonical_coder *impl = userdata;
+    return impl->codes[symbol];
+}
+
+static uint8_t s_decode_symbol(uint32_t bits, uint8_t *symbol, void *userdata) {
+
+    struct canonical_coder *impl = userdata;
+
+    const struct primary_table_entry *entry = &impl->primary_table[bits >> (MAX_CODE_LENGTH - impl->primary_bits)];
+    if (entry->num_bits) {
+        *symbol = entry->symbol;
+        return entry->num_bits;
+    }
+
+    for (uint8_t len = impl->primary_bits + 1; len <= impl->coder.max_code_length; ++len) {
+        const uint32_t code = bits >> (MAX_CODE_LENGTH - len);
+        const uint32_t index = code - impl->first_code[len];
+        if (index < impl->count[len]) {
+            *symbol = impl->sorted_symbols[impl->first_index[len] + index];
+            return len;
+        }
+    }
+
+    /* Unused prefix of an incomplete code */
+    return 0;
+}
+
+/* Count the codes of each length, and check they describe a prefix code (complete if no code is left unused) */
+static int s_count_code_lengths(const uint8_t *code_lengths, uint16_t *count, bool *is_complete) {
+
+    for (size_t i = 0; i <= MAX_CODE_LENGTH; ++i) {
+        count[i] = 0;
+    }
+
+    for (size_t i = 0; i < 256; ++i) {
+        if (code_lengths[i] > MAX_CODE_LENGTH) {
+            return aws_raise_error(AWS_ERROR_COMPRESSION_INVALID_CODE_LENGTHS);
+        }
+        ++count[code_lengths[i]];
+    }
+    count[0] = 0;
+
+    /* Kraft's inequality */
+    uint64_t kraft_sum = 0;
+    for (uint8_t len = 1; len <= MAX_CODE_LENGTH; ++len) {
+        kraft_sum += (uint64_t)count[len] << (MAX_CODE_LENGTH - len);
+    }
+    if (kraft_sum == 0 || kraft_sum > ((uint64_t)1 << MAX_CODE_LENGTH)) {
+        return aws_raise_error(AWS_ERROR_COMPRESSION_INVALID_CODE_LENGTHS);
+    }
+
+    *is_complete = kraft_sum == ((uint64_t)1 << MAX_CODE_LENGTH);
+    return AWS_OP_SUCCESS;
+}
+
+int aws_huffman_assign_canonical_codes(const uint8_t *code_lengths, struct aws_huffman_code *codes) {
+
+    AWS_PRECONDITION(code_lengths);
+    AWS_PRECONDITION(codes);
+
+    uint16_t count[MAX_CODE_LENGTH + 1];
+    bool is_complete = false;
+    if (s_count_code_lengths(code_lengths, count, &is_complete)) {
+        return AWS_OP_ERR;
+    }
+
+    /* The first code of each length follows on from the last code of the length before */
+    uint32_t next_code[MAX_CODE_LENGTH + 1];
+    uint32_t code = 0;
+    for (uint8_t len = 1; len <= MAX_CODE_LENGTH; ++len) {
+        code = (code + count[len - 1]) << 1;
+        next_code[len] = code;
+    }
+
+    for (size_t symbol = 0; symbol < 256; ++symbol) {
+        const uint8_t len = code_lengths[symbol];
+        codes[symbol].num_bits = len;
+        codes[symbol].pattern = len ? next_code[len]++ : 0;
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+struct aws_huffman_symbol_coder *aws_huffman_coder_new_from_lengths(
+    struct aws_allocator *allocator,
+    const uint8_t *code_lengths) {
+
+    AWS_PRECONDITION(allocator);
+    AWS_PRECONDITION(code_lengths);
+
+    uint16_t count[MAX_CODE_LENGTH + 1];
+    bool is_complete = false;
+    if (s_count_code_lengths(code_lengths, count, &is_complete)) {
+        return NULL;
+    }
+
+    /*
+     * Canonical codes count up from 0, so when the code is complete its last, longest code is all 1s. If that is
+     * short enough to fit in the end of stream padding, the padding would decode as real symbols.
+     */
+    if (is_complete) {
+        uint8_t longest = MAX_CODE_LENGTH;
+        while (count[longest] == 0) {
+            --longest;
+        }
+        if (longest <= MAX_PADDING_BITS) {
+            aws_raise_error(AWS_ERROR_COMPRESSION_INVALID_CODE_LENGTHS);
+            return NULL;
+        }
+    }
+
+    struct canonical_coder *impl = aws_mem_acquire(allocator, sizeof(struct canonical_coder));
+    if (!impl) {
+        return NULL;
+    }
+    AWS_ZERO_STRUCT(*impl);
+
+    impl->allocator = allocator;
+    memcpy(impl->code_lengths, code_lengths, sizeof(impl->code_lengths));
+    memcpy(impl->count, count, sizeof(impl->count));
+
+    impl->coder.encode = s_encode_symbol;
+    impl->coder.decode = s_decode_symbol;
+    impl->coder.userdata = impl;
+    impl->coder.code_lengths = impl->code_lengths;
+    impl->coder.packed_codes = impl->packed_codes;
+
+    aws_huffman_assign_canonical_codes(code_lengths, impl->codes);
+
+    /* Codes too long to pack keep their 0 entry and are encoded through s_encode_symbol */
+    for (size_t symbol = 0; symbol < 256; ++symbol) {
+        const struct aws_huffman_code code = impl->codes[symbol];
+        if (code.num_bits && code.num_bits <= AWS_HUFFMAN_PACKED_MAX_CODE_LENGTH) {
+            impl->packed_codes[symbol] = (1u << code.num_bits) | code.pattern;
+        }
+    }
+
+    /* Index the symbols of each length, in code order */
+    uint16_t index = 0;
+    for (uint8_t len = 1; len <= MAX_CODE_LENGTH; ++len) {
+        if (count[len] == 0) {
+            continue;
+        }
+
+        if (!impl->coder.min_code_length) {
+            impl->coder.min_code_length = len;
+        }
+        impl->coder.max_code_length = len;
+
+        impl->first_index[len] = index;
+        for (size_t symbol = 0; symbol < 256; ++symbol) {
+            if (code_lengths[symbol] == len) {
+                if (index == impl->first_index[len]) {
+                    impl->first_code[len] = impl->codes[symbol].pattern;
+                }
+                impl->sorted_symbols[index++] = (uint8_t)symbol;
+            }
+        }
+    }
+
+    /*
+     * An incomplete code leaves the all 1s prefix unused. Treat it like HPACK's EOS code, which is longer than any
+     * padding: with max_code_length past MAX_PADDING_BITS, decoders wait for more input on a padded last byte
+     * instead of rejecting it, but still reject the unused prefix anywhere else.
+     */
+    if (!is_complete && impl->coder.max_code_length <= MAX_PADDING_BITS) {
+        impl->coder.max_code_length = MAX_PADDING_BITS + 1;
+    }
+
+    impl->primary_bits = impl->coder.max_code_length < PRIMARY_TABLE_BITS ? impl->coder.max_code_length
+                                                                            : PRIMARY_TABLE_BITS;
+
+    /* Every prefix that starts with a short code resolves to it */
+    for (size_t symbol = 0; symbol < 256; ++symbol) {
+        const uint8_t len = code_lengths[symbol];
+        if (len == 0 || len > impl->primary_bits) {
+            continue;
+        }
+
+        const uint8_t fill_bits = impl->primary_bits - len;
+        const uint32_t first = impl->codes[symbol].pattern << fill_bits;
+        for (uint32_t i = 0; i < (1u << fill_bits); ++i) {
+            impl->primary_table[first + i].symbol = (uint8_t)symbol;
+            impl->primary_table[first + i].num_bits = len;
+        }
+    }
+
+    return &impl->coder;
+}
+
+void aws_huffman_coder_destroy(struct aws_huffman_symbol_coder *coder) {
+
+    if (!coder) {
+        return;
+    }
+
+    struct canonical_coder *impl = coder->userdata;
+    aws_mem_release(impl->allocator, impl);
+}
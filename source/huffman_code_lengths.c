@@ -0,0 +1,160 @@
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/compression/huffman.h>
+
+#include <stdlib.h>
+
+#define BITSIZEOF(val) (sizeof(val) * 8)
+
+enum {
+    MAX_CODE_LENGTH = BITSIZEOF(((struct aws_huffman_code *)0)->pattern),
+    /* Encoders pad the last byte with up to this many bits of eos_padding, all 1s by default */
+    MAX_PADDING_BITS = 7,
+    /* Stands in for an end of stream symbol, which takes the all 1s code so no real symbol does */
+    SENTINEL_SYMBOL = 256,
+    /* Each list holds every leaf, plus a package for each pair from the list below it */
+    MAX_LIST_ITEMS = (256 + 1) * 2 - 1,
+};
+
+struct leaf {
+    uint64_t frequency;
+    uint16_t symbol;
+};
+
+static int s_compare_leaves(const void *a, const void *b) {
+
+    const struct leaf *leaf_a = a;
+    const struct leaf *leaf_b = b;
+
+    if (leaf_a->frequency != leaf_b->frequency) {
+        return leaf_a->frequency < leaf_b->frequency ? -1 : 1;
+    }
+    return leaf_a->symbol < leaf_b->symbol ? -1 : 1;
+}
+
+int aws_huffman_code_lengths_from_frequencies(
+    const uint64_t *frequencies,
+    uint8_t max_code_length,
+    uint8_t *code_lengths) {
+
+    AWS_PRECONDITION(frequencies);
+    AWS_PRECONDITION(code_lengths);
+
+    struct leaf leaves[256 + 1];
+    size_t num_leaves = 0;
+
+    for (size_t i = 0; i < 256; ++i) {
+        code_lengths[i] = 0;
+        if (frequencies[i]) {
+            leaves[num_leaves].frequency = frequencies[i];
+            leaves[num_leaves].symbol = (uint16_t)i;
+            ++num_leaves;
+        }
+    }
+
+    /* Without room for the sentinel, every code must be longer than the padding */
+    if (num_leaves == 0 || max_code_length == 0 || max_code_length > MAX_CODE_LENGTH ||
+        (max_code_length <= MAX_PADDING_BITS && num_leaves >= (1u << max_code_length))) {
+        return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+    }
+
+    /*
+     * The end of stream padding must not decode as a symbol, so like HPACK's EOS, a sentinel that never occurs takes
+     * the longest code. It sorts after every symbol, so in the canonical code it has the all 1s code, which is left
+     * unused. This also gives a single symbol a second code, as a code needs at least one bit. The sentinel only
+     * doesn't fit when all 256 symbols take 8 bits, and then the all 1s code is longer than the padding anyway.
+     */
+    if (max_code_length > 8 || num_leaves < (1u << max_code_length)) {
+        leaves[num_leaves].frequency = 0;
+        leaves[num_leaves].symbol = SENTINEL_SYMBOL;
+        ++num_leaves;
+    }
+
+    qsort(leaves, num_leaves, sizeof(struct leaf), s_compare_leaves);
+
+    /*
+     * Package-merge: the list for the longest length holds just the leaves.
+     * Each shorter length's list merges the leaves with packages made from
+     * adjacent pairs in the list below it. Only which items are packages needs
+     * to be remembered: leaves are always merged in order, so the leaves among
+     * the first n items of a list are always the smallest ones.
+     */
+    uint64_t is_package[MAX_CODE_LENGTH][(MAX_LIST_ITEMS + 63) / 64];
+    size_t list_len[MAX_CODE_LENGTH];
+    AWS_ZERO_ARRAY(is_package);
+
+    uint64_t weights[2][MAX_LIST_ITEMS];
+    uint64_t *previous = weights[0];
+    uint64_t *current = weights[1];
+
+    for (size_t i = 0; i < num_leaves; ++i) {
+        previous[i] = leaves[i].frequency;
+    }
+    size_t previous_len = num_leaves;
+    list_len[max_code_length - 1] = num_leaves;
+
+    for (int level = max_code_length - 2; level >= 0; --level) {
+        const size_t num_packages = previous_len / 2;
+        size_t leaf = 0;
+        size_t package = 0;
+        size_t len = 0;
+
+        while (leaf < num_leaves || package < num_packages) {
+            const uint64_t package_weight =
+                package < num_packages ? previous[package * 2] + previous[package * 2 + 1] : UINT64_MAX;
+
+            if (leaf < num_leaves && leaves[leaf].frequency <= package_weight) {
+                current[len++] = leaves[leaf++].frequency;
+            } else {
+                is_package[level][len / 64] |= (uint64_t)1 << (len % 64);
+                current[len++] = package_weight;
+                ++package;
+            }
+        }
+
+        list_len[level] = len;
+        previous_len = len;
+
+        uint64_t *swap = previous;
+        previous = current;
+        current = swap;
+    }
+
+    /*
+     * An optimal code takes the first 2n - 2 items of the shortest length's
+     * list. Every leaf taken adds a bit to its code, and every package taken
+     * takes the 2 items it was made from in the next list down.
+     */
+    size_t num_taken = num_leaves * 2 - 2;
+    for (size_t level = 0; level < max_code_length && num_taken; ++level) {
+        AWS_ASSERT(num_taken <= list_len[level]);
+
+        size_t num_packages = 0;
+        for (size_t i = 0; i < num_taken; ++i) {
+            num_packages += (is_package[level][i / 64] >> (i % 64)) & 1;
+        }
+
+        for (size_t i = 0; i < num_taken - num_packages; ++i) {
+            if (leaves[i].symbol != SENTINEL_SYMBOL) {
+                ++code_lengths[leaves[i].symbol];
+            }
+        }
+
+        num_taken = num_packages * 2;
+    }
+
+    return AWS_OP_SUCCESS;
+}
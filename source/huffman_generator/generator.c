@@ -33,6 +33,20 @@ struct huffman_code_point {
 enum { num_code_points = 256 };
 static struct huffman_code_point code_points[num_code_points];
 
+/* Matches AWS_HUFFMAN_PACKED_MAX_CODE_LENGTH, codes longer than this get no packed entry */
+enum { packed_max_code_length = 31 };
+
+/* The shortest and longest codes in code_points, set by read_code_points */
+static uint8_t min_code_length;
+static uint8_t max_code_length;
+
+enum decoder_type {
+    DECODER_TREE,
+    DECODER_TABLE,
+    DECODER_MULTI,
+    DECODER_CANONICAL,
+};
+
 static size_t skip_whitespace(const char *str) {
     size_t offset = 0;
     while (str[offset] == ' ' || str[offset] == '\t') {
@@ -111,6 +125,26 @@ int read_code_points(const char *input_path) {
 
     fclose(file);
 
+    min_code_length = UINT8_MAX;
+    max_code_length = 0;
+    for (size_t i = 0; i < num_code_points; ++i) {
+        const uint8_t num_bits = code_points[i].code.num_bits;
+        if (num_bits == 0) {
+            continue;
+        }
+        if (num_bits < min_code_length) {
+            min_code_length = num_bits;
+        }
+        if (num_bits > max_code_length) {
+            max_code_length = num_bits;
+        }
+    }
+
+    if (max_code_length == 0) {
+        printf("No codes found in file '%s'.", input_path);
+        return 1;
+    }
+
     return 0;
 }
 
@@ -160,6 +194,9 @@ void huffman_node_clean_up(struct huffman_node *node) {
     memset(node, 0, sizeof(struct huffman_node));
 }
 
+/* Bit tests written into the tree decoder's decode_symbol, reported instead of a table size */
+static size_t decode_tree_branches;
+
 /* This function writes what to do if the pattern for node is a match */
 void huffman_node_write_decode_handle_value(struct huffman_node *node, FILE *file) {
 
@@ -204,6 +241,7 @@ void huffman_node_write_decode(struct huffman_node *node, FILE *file, uint8_t cu
     uint32_t left_aligned_pattern = ((node->code.bits << 1) + 1) << (31 - node->code.num_bits);
     uint32_t check_pattern = left_aligned_pattern & single_bit_mask;
     fprintf(file, "    if (bits & 0x%x) {\n", check_pattern);
+    ++decode_tree_branches;
 
     huffman_node_write_decode_handle_value(node->children[1], file);
 
@@ -223,15 +261,509 @@ void huffman_node_write_decode(struct huffman_node *node, FILE *file, uint8_t cu
     }
 }
 
+/* Maximum number of bits resolved by each level of the lookup table decoder (--table-bits) */
+static uint8_t decode_table_primary_bits = 9;
+
+/* The range allowed for --table-bits */
+enum { min_table_bits = 6, max_table_bits = 12 };
+
+/* Bytes of decode tables written, reported when the generator finishes */
+static size_t decode_footprint;
+
+struct decode_table_entry {
+    /* The decoded symbol, or the offset of the sub table if sub_bits is set */
+    uint16_t value;
+    /* Total length of the decoded code, 0 if this entry is a sub table link or invalid */
+    uint8_t num_bits;
+    /* Number of bits used to index the sub table, 0 if this entry is a symbol or invalid */
+    uint8_t sub_bits;
+};
+
+static struct decode_table_entry *decode_table;
+static size_t decode_table_size;
+
+/* Returns the length of the longest path from node to a leaf */
+uint8_t huffman_node_max_depth(struct huffman_node *node) {
+
+    if (!node || node->value) {
+        return 0;
+    }
+
+    uint8_t max_depth = 0;
+    for (int i = 0; i < 2; ++i) {
+        uint8_t child_depth = huffman_node_max_depth(node->children[i]);
+        if (child_depth > max_depth) {
+            max_depth = child_depth;
+        }
+    }
+    return max_depth + 1;
+}
+
+/* Builds a table indexed by the next table_bits bits below node, recursively building sub tables for any codes that
+   don't fit. Returns the offset of the new table in decode_table. */
+size_t decode_table_build(struct huffman_node *node, uint8_t table_bits) {
+
+    const size_t num_entries = (size_t)1 << table_bits;
+    const size_t table_offset = decode_table_size;
+
+    decode_table_size += num_entries;
+    decode_table = realloc(decode_table, decode_table_size * sizeof(struct decode_table_entry));
+    memset(&decode_table[table_offset], 0, num_entries * sizeof(struct decode_table_entry));
+
+    for (size_t index = 0; index < num_entries; ++index) {
+
+        /* Walk down the tree following the bits of index, most significant first */
+        struct huffman_node *current = node;
+        for (int bit_idx = table_bits - 1; bit_idx >= 0 && current && !current->value; --bit_idx) {
+            current = current->children[(index >> bit_idx) & 0x1];
+        }
+
+        struct decode_table_entry entry;
+        memset(&entry, 0, sizeof(entry));
+
+        if (!current) {
+            /* No code has this prefix, leave the entry invalid */
+        } else if (current->value) {
+            entry.value = current->value->symbol;
+            entry.num_bits = current->value->code.num_bits;
+        } else {
+            /* Codes continue past this table, link to a sub table */
+            uint8_t sub_bits = huffman_node_max_depth(current);
+            if (sub_bits > decode_table_primary_bits) {
+                sub_bits = decode_table_primary_bits;
+            }
+
+            /* Note: this may realloc decode_table, so don't hold pointers into it across the call */
+            size_t sub_offset = decode_table_build(current, sub_bits);
+            assert(sub_offset <= UINT16_MAX && "Decode table too large!");
+
+            entry.value = (uint16_t)sub_offset;
+            entry.sub_bits = sub_bits;
+        }
+
+        decode_table[table_offset + index] = entry;
+    }
+
+    return table_offset;
+}
+
+void decode_table_write(struct huffman_node *tree_root, FILE *file) {
+
+    decode_table_build(tree_root, decode_table_primary_bits);
+
+    fprintf(
+        file,
+        "struct decode_table_entry {\n"
+        "    uint16_t value;\n"
+        "    uint8_t num_bits;\n"
+        "    uint8_t sub_bits;\n"
+        "};\n"
+        "\n"
+        "/* { value, num_bits, sub_bits }: %zu entries, %zu bytes */\n"
+        "static const struct decode_table_entry decode_table[] = {\n",
+        decode_table_size,
+        decode_table_size * sizeof(struct decode_table_entry));
+    decode_footprint += decode_table_size * sizeof(struct decode_table_entry);
+
+    for (size_t i = 0; i < decode_table_size; ++i) {
+        const struct decode_table_entry *entry = &decode_table[i];
+        if (i % 8 == 0) {
+            fprintf(file, "    ");
+        }
+        fprintf(file, "{ %u, %u, %u },", entry->value, entry->num_bits, entry->sub_bits);
+        fprintf(file, (i % 8 == 7 || i + 1 == decode_table_size) ? "\n" : " ");
+    }
+
+    fprintf(
+        file,
+        "};\n"
+        "\n"
+        "static uint8_t decode_symbol(uint32_t bits, uint8_t *symbol, void *userdata) {\n"
+        "    (void)userdata;\n"
+        "\n"
+        "    const struct decode_table_entry *entry = &decode_table[bits >> %u];\n"
+        "    uint8_t bits_used = %u;\n"
+        "    while (entry->sub_bits) {\n"
+        "        const uint32_t index = (bits << bits_used) >> (32 - entry->sub_bits);\n"
+        "        bits_used += entry->sub_bits;\n"
+        "        entry = &decode_table[entry->value + index];\n"
+        "    }\n"
+        "\n"
+        "    if (entry->num_bits) {\n"
+        "        *symbol = (uint8_t)entry->value;\n"
+        "    }\n"
+        "    return entry->num_bits;\n"
+        "}\n",
+        32 - decode_table_primary_bits,
+        decode_table_primary_bits);
+
+    free(decode_table);
+    decode_table = NULL;
+    decode_table_size = 0;
+}
+
+/* Number of bits used to index the multi symbol table (--table-bits) */
+static uint8_t multi_decode_table_bits = 12;
+/* Must not exceed AWS_HUFFMAN_MAX_DECODE_SYMBOLS */
+enum { multi_decode_max_symbols_limit = 4 };
+/* Most symbols stored in one multi symbol table entry (--max-symbols) */
+static uint8_t multi_decode_max_symbols = multi_decode_max_symbols_limit;
+
+/* Writes a table that decodes every whole code in a multi_decode_table_bits wide window at once. Entries that don't
+   contain a whole code fall back to decode_symbol, so decode_table_write must have been called first. */
+void multi_decode_table_write(struct huffman_node *tree_root, FILE *file) {
+
+    /* The shortest code determines how many symbols can fit in one window */
+    size_t max_symbols = multi_decode_table_bits / min_code_length;
+    if (max_symbols > multi_decode_max_symbols) {
+        max_symbols = multi_decode_max_symbols;
+    }
+    if (max_symbols == 0) {
+        max_symbols = 1;
+    }
+
+    const size_t num_entries = (size_t)1 << multi_decode_table_bits;
+    const size_t entry_size = 2 + max_symbols;
+
+    fprintf(
+        file,
+        "\n"
+        "struct multi_decode_table_entry {\n"
+        "    uint8_t num_bits;\n"
+        "    uint8_t num_symbols;\n"
+        "    uint8_t symbols[%zu];\n"
+        "};\n"
+        "\n"
+        "/* { num_bits, num_symbols, { symbols } }: %zu entries, %zu bytes */\n"
+        "static const struct multi_decode_table_entry multi_decode_table[] = {\n",
+        max_symbols,
+        num_entries,
+        num_entries * entry_size);
+    decode_footprint += num_entries * entry_size;
+
+    for (size_t index = 0; index < num_entries; ++index) {
+
+        uint8_t symbols[multi_decode_max_symbols_limit];
+        memset(symbols, 0, sizeof(symbols));
+        size_t num_symbols = 0;
+        size_t num_bits = 0;
+
+        /* Greedily decode whole codes from the window, most significant bit first */
+        struct huffman_node *current = tree_root;
+        for (int bit_idx = multi_decode_table_bits - 1; bit_idx >= 0 && num_symbols < max_symbols; --bit_idx) {
+            current = current->children[(index >> bit_idx) & 0x1];
+            if (!current) {
+                /* Invalid code, stop and let decode_symbol report it */
+                break;
+            }
+            if (current->value) {
+                symbols[num_symbols++] = current->value->symbol;
+                num_bits = multi_decode_table_bits - bit_idx;
+                current = tree_root;
+            }
+        }
+
+        if (index % 4 == 0) {
+            fprintf(file, "    ");
+        }
+        fprintf(file, "{ %zu, %zu, { ", num_bits, num_symbols);
+        for (size_t i = 0; i < max_symbols; ++i) {
+            fprintf(file, i + 1 < max_symbols ? "%u, " : "%u", symbols[i]);
+        }
+        fprintf(file, " } },");
+        fprintf(file, (index % 4 == 3 || index + 1 == num_entries) ? "\n" : " ");
+    }
+
+    fprintf(
+        file,
+        "};\n"
+        "\n"
+        "static uint8_t decode_symbols(uint32_t bits, uint8_t *symbols, uint8_t *num_symbols, void *userdata) {\n"
+        "\n"
+        "    const struct multi_decode_table_entry *entry = &multi_decode_table[bits >> %u];\n"
+        "    if (entry->num_symbols == 0) {\n"
+        "        /* The window doesn't contain a whole code */\n"
+        "        *num_symbols = 1;\n"
+        "        return decode_symbol(bits, symbols, userdata);\n"
+        "    }\n"
+        "\n"
+        "    memcpy(symbols, entry->symbols, sizeof(entry->symbols));\n"
+        "    *num_symbols = entry->num_symbols;\n"
+        "    return entry->num_bits;\n"
+        "}\n",
+        32 - multi_decode_table_bits);
+}
+
+/* Orders codes by their value when left aligned, which for a canonical code also orders them by length */
+static int canonical_code_compare(const void *a, const void *b) {
+
+    const struct huffman_code *code_a = &((const struct huffman_code_point *)a)->code;
+    const struct huffman_code *code_b = &((const struct huffman_code_point *)b)->code;
+    const uint64_t aligned_a = (uint64_t)code_a->bits << (32 - code_a->num_bits);
+    const uint64_t aligned_b = (uint64_t)code_b->bits << (32 - code_b->num_bits);
+    return aligned_a < aligned_b ? -1 : aligned_a > aligned_b;
+}
+
+/* Writes a decoder that finds each code's length by comparing the left aligned window against the last code of each
+   length, then indexes a table of symbols sorted by code. This only works if, ordered by value, the codes of each
+   length are consecutive and come after all shorter codes (as in a canonical code). Returns non-zero if they aren't. */
+int canonical_decoder_write(FILE *file) {
+
+    struct huffman_code_point sorted[num_code_points];
+    size_t num_codes = 0;
+    for (size_t i = 0; i < num_code_points; ++i) {
+        if (code_points[i].code.num_bits) {
+            sorted[num_codes++] = code_points[i];
+        }
+    }
+    qsort(sorted, num_codes, sizeof(sorted[0]), canonical_code_compare);
+
+    struct canonical_length {
+        uint64_t limit;
+        uint32_t first_code;
+        uint16_t first_index;
+        uint8_t num_bits;
+    } lengths[32];
+    size_t num_lengths = 0;
+
+    for (size_t i = 0; i < num_codes; ++i) {
+        const struct huffman_code *code = &sorted[i].code;
+        struct canonical_length *length = num_lengths ? &lengths[num_lengths - 1] : NULL;
+
+        if (!length || code->num_bits != length->num_bits) {
+            if (length && code->num_bits < length->num_bits) {
+                fprintf(
+                    stderr,
+                    "Symbol %u: a shorter code follows a longer one, so the code isn't canonical\n",
+                    sorted[i].symbol);
+                return 1;
+            }
+            length = &lengths[num_lengths++];
+            length->first_code = code->bits;
+            length->first_index = (uint16_t)i;
+            length->num_bits = code->num_bits;
+        } else if (code->bits != length->first_code + (i - length->first_index)) {
+            fprintf(
+                stderr,
+                "Symbol %u: the codes of length %u aren't consecutive, so the code isn't canonical\n",
+                sorted[i].symbol,
+                code->num_bits);
+            return 1;
+        }
+
+        length->limit = ((uint64_t)code->bits + 1) << (32 - code->num_bits);
+    }
+
+    fprintf(file, "/* Symbols ordered by code: %zu bytes */\n", num_codes);
+    fprintf(file, "static const uint8_t sorted_symbols[] = {\n");
+    for (size_t i = 0; i < num_codes; ++i) {
+        if (i % 16 == 0) {
+            fprintf(file, "    ");
+        }
+        fprintf(file, "%u,", sorted[i].symbol);
+        fprintf(file, (i % 16 == 15 || i + 1 == num_codes) ? "\n" : " ");
+    }
+
+    fprintf(
+        file,
+        "};\n"
+        "\n"
+        "struct canonical_length {\n"
+        "    uint64_t limit;\n"
+        "    uint32_t first_code;\n"
+        "    uint16_t first_index;\n"
+        "    uint8_t num_bits;\n"
+        "};\n"
+        "\n"
+        "/* { limit, first_code, first_index, num_bits }: %zu lengths, %zu bytes */\n"
+        "static const struct canonical_length lengths[] = {\n",
+        num_lengths,
+        num_lengths * sizeof(struct canonical_length));
+    decode_footprint += num_codes + num_lengths * sizeof(struct canonical_length);
+
+    for (size_t i = 0; i < num_lengths; ++i) {
+        fprintf(
+            file,
+            "    { 0x%llxull, %u, %u, %u },\n",
+            (unsigned long long)lengths[i].limit,
+            lengths[i].first_code,
+            lengths[i].first_index,
+            lengths[i].num_bits);
+    }
+
+    fprintf(
+        file,
+        "};\n"
+        "\n"
+        "static uint8_t decode_symbol(uint32_t bits, uint8_t *symbol, void *userdata) {\n"
+        "    (void)userdata;\n"
+        "\n"
+        "    /* The code's length is the first whose limit bits is below. Counting the limits bits is at or above\n"
+        "       finds it without branching */\n"
+        "    size_t index = 0;\n"
+        "    for (size_t i = 0; i < %zu; ++i) {\n"
+        "        index += bits >= lengths[i].limit;\n"
+        "    }\n"
+        "    if (index == %zu) {\n"
+        "        /* Past the last code */\n"
+        "        return 0;\n"
+        "    }\n"
+        "\n"
+        "    const struct canonical_length *length = &lengths[index];\n"
+        "    const uint32_t code = bits >> (32 - length->num_bits);\n"
+        "    if (code < length->first_code) {\n"
+        "        /* Between the last shorter code and the first code of this length */\n"
+        "        return 0;\n"
+        "    }\n"
+        "\n"
+        "    *symbol = sorted_symbols[length->first_index + (code - length->first_code)];\n"
+        "    return length->num_bits;\n"
+        "}\n",
+        num_lengths,
+        num_lengths);
+
+    return 0;
+}
+
+/* Writes a decode loop specialized for the lookup tables, which aws_huffman_decode dispatches to */
+void decode_buffer_write(FILE *file, enum decoder_type decoder_type) {
+
+    /* Refill once there may not be a whole code (or a whole multi symbol window) left in working_bits */
+    uint8_t refill_bits = max_code_length;
+    if (decoder_type == DECODER_MULTI && refill_bits < multi_decode_table_bits) {
+        refill_bits = multi_decode_table_bits;
+    }
+
+    fprintf(
+        file,
+        "\n"
+        "static enum aws_huffman_status decode_buffer(\n"
+        "    struct aws_huffman_decoder *decoder,\n"
+        "    struct aws_byte_cursor *to_decode,\n"
+        "    struct aws_byte_buf *output,\n"
+        "    void *userdata) {\n"
+        "    (void)userdata;\n"
+        "\n"
+        "    uint64_t working_bits = decoder->working_bits;\n"
+        "    uint8_t num_bits = decoder->num_bits;\n"
+        "    const uint8_t *input = to_decode->ptr;\n"
+        "    const uint8_t *input_end = to_decode->ptr + to_decode->len;\n"
+        "    uint8_t *out = output->buffer + output->len;\n"
+        "    uint8_t *out_end = output->buffer + output->capacity;\n"
+        "\n"
+        "    enum aws_huffman_status status = AWS_HUFFMAN_NEED_INPUT;\n"
+        "    while (1) {\n"
+        "        if (num_bits < %u) {\n"
+        "            if (input_end - input >= (ptrdiff_t)sizeof(uint64_t)) {\n"
+        "                /* Top up with a single unaligned big-endian load, keeping as many whole bytes as fit */\n"
+        "                const uint8_t num_bytes = (63 - num_bits) / 8;\n"
+        "                uint64_t new_bits = 0;\n"
+        "                memcpy(&new_bits, input, sizeof(new_bits));\n"
+        "                new_bits = aws_ntoh64(new_bits) & (UINT64_MAX << (64 - num_bytes * 8));\n"
+        "\n"
+        "                working_bits |= new_bits >> num_bits;\n"
+        "                num_bits += num_bytes * 8;\n"
+        "                input += num_bytes;\n"
+        "            } else {\n"
+        "                while (num_bits <= 56 && input != input_end) {\n"
+        "                    working_bits |= (uint64_t)*input++ << (56 - num_bits);\n"
+        "                    num_bits += 8;\n"
+        "                }\n"
+        "            }\n"
+        "        }\n"
+        "\n"
+        "        if (num_bits == 0) {\n"
+        "            /* Successfully decoded whole buffer */\n"
+        "            break;\n"
+        "        }\n"
+        "\n"
+        "        const uint32_t bits = (uint32_t)(working_bits >> 32);\n",
+        refill_bits);
+
+    if (decoder_type == DECODER_MULTI) {
+        fprintf(
+            file,
+            "\n"
+            "        const struct multi_decode_table_entry *multi_entry = &multi_decode_table[bits >> %u];\n"
+            "        if (multi_entry->num_symbols && multi_entry->num_bits <= num_bits &&\n"
+            "            (size_t)(out_end - out) >= sizeof(multi_entry->symbols)) {\n"
+            "\n"
+            "            memcpy(out, multi_entry->symbols, sizeof(multi_entry->symbols));\n"
+            "            out += multi_entry->num_symbols;\n"
+            "            working_bits <<= multi_entry->num_bits;\n"
+            "            num_bits -= multi_entry->num_bits;\n"
+            "            continue;\n"
+            "        }\n",
+            32 - multi_decode_table_bits);
+    }
+
+    fprintf(
+        file,
+        "\n"
+        "        uint8_t symbol = 0;\n"
+        "        const uint8_t bits_read = decode_symbol(bits, &symbol, NULL);\n"
+        "\n"
+        "        if (bits_read == 0) {\n"
+        "            if (input == input_end && num_bits < %u) {\n"
+        "                /* More input is needed to continue */\n"
+        "                break;\n"
+        "            }\n"
+        "            /* Unknown symbol found */\n"
+        "            aws_raise_error(AWS_ERROR_COMPRESSION_UNKNOWN_SYMBOL);\n"
+        "            status = AWS_HUFFMAN_ERROR;\n"
+        "            break;\n"
+        "        }\n"
+        "        if (bits_read > num_bits) {\n"
+        "            /* The rest of the input is part of a symbol that isn't complete yet */\n"
+        "            break;\n"
+        "        }\n"
+        "        if (out == out_end) {\n"
+        "            status = AWS_HUFFMAN_NEED_OUTPUT;\n"
+        "            break;\n"
+        "        }\n"
+        "\n"
+        "        working_bits <<= bits_read;\n"
+        "        num_bits -= bits_read;\n"
+        "        *out++ = symbol;\n"
+        "    }\n"
+        "\n"
+        "    decoder->working_bits = working_bits;\n"
+        "    decoder->num_bits = num_bits;\n"
+        "    aws_byte_cursor_advance(to_decode, (size_t)(input - to_decode->ptr));\n"
+        "    output->len = (size_t)(out - output->buffer);\n"
+        "\n"
+        "    return status;\n"
+        "}\n",
+        max_code_length);
+}
+
 int main(int argc, char *argv[]) {
 
-    if (argc != 4) {
+    if (argc < 4) {
         fprintf(
             stderr,
             "generator expects 3 arguments: [input file] [output file] "
-            "[encoding name]\n"
-            "A function of the following signature will be exported:\n"
-            "struct aws_huffman_symbol_coder *[encoding name]_get_coder()\n");
+            "[encoding name] [options]\n"
+            "Functions of the following signatures will be exported:\n"
+            "struct aws_huffman_symbol_coder *[encoding name]_get_coder()\n"
+            "int [encoding name]_encode(encoder, to_encode, output)\n"
+            "int [encoding name]_decode(decoder, to_decode, output)\n"
+            "(see AWS_HUFFMAN_DECLARE_STATIC_CODER)\n"
+            "Options:\n"
+            "  --decoder=tree   Decode with a branch per bit (default)\n"
+            "  --decoder=table  Decode with multi-level lookup tables\n"
+            "  --decoder=multi  Decode with lookup tables that may return several symbols at once\n"
+            "  --decoder=canonical  Decode by comparing against the last code of each length\n"
+            "                       (canonical codes only)\n"
+            "  --table-bits=N   Bits indexed by each lookup table, %u to %u (default %u, or %u for the multi symbol "
+            "table)\n"
+            "  --max-symbols=N  Most symbols in each multi symbol table entry, 1 to %u (default %u)\n",
+            min_table_bits,
+            max_table_bits,
+            decode_table_primary_bits,
+            multi_decode_table_bits,
+            multi_decode_max_symbols_limit,
+            multi_decode_max_symbols);
         return 1;
     }
 
@@ -239,6 +771,37 @@ int main(int argc, char *argv[]) {
     const char *output_file = argv[2];
     const char *decoder_name = argv[3];
 
+    enum decoder_type decoder_type = DECODER_TREE;
+    for (int i = 4; i < argc; ++i) {
+        if (strcmp(argv[i], "--decoder=tree") == 0) {
+            decoder_type = DECODER_TREE;
+        } else if (strcmp(argv[i], "--decoder=table") == 0) {
+            decoder_type = DECODER_TABLE;
+        } else if (strcmp(argv[i], "--decoder=multi") == 0) {
+            decoder_type = DECODER_MULTI;
+        } else if (strcmp(argv[i], "--decoder=canonical") == 0) {
+            decoder_type = DECODER_CANONICAL;
+        } else if (strncmp(argv[i], "--table-bits=", 13) == 0) {
+            const int table_bits = atoi(argv[i] + 13);
+            if (table_bits < min_table_bits || table_bits > max_table_bits) {
+                fprintf(stderr, "--table-bits must be from %u to %u\n", min_table_bits, max_table_bits);
+                return 1;
+            }
+            decode_table_primary_bits = (uint8_t)table_bits;
+            multi_decode_table_bits = (uint8_t)table_bits;
+        } else if (strncmp(argv[i], "--max-symbols=", 14) == 0) {
+            const int max_symbols = atoi(argv[i] + 14);
+            if (max_symbols < 1 || max_symbols > multi_decode_max_symbols_limit) {
+                fprintf(stderr, "--max-symbols must be from 1 to %u\n", multi_decode_max_symbols_limit);
+                return 1;
+            }
+            multi_decode_max_symbols = (uint8_t)max_symbols;
+        } else {
+            fprintf(stderr, "Unknown option '%s'\n", argv[i]);
+            return 1;
+        }
+    }
+
     if (read_code_points(input_file)) {
         return 1;
     }
@@ -298,79 +861,183 @@ int main(int argc, char *argv[]) {
     fprintf(
         file,
         "/*\n"
-        "* Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights "
+        " * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights "
         "Reserved.\n"
-        "*\n"
-        "* Licensed under the Apache License, Version 2.0 (the \"License\").\n"
-        "* You may not use this file except in compliance with the License.\n"
-        "* A copy of the License is located at\n"
-        "*\n"
-        "*  http://aws.amazon.com/apache2.0\n"
-        "*\n"
-        "* or in the \"license\" file accompanying this file. This file is "
+        " *\n"
+        " * Licensed under the Apache License, Version 2.0 (the \"License\").\n"
+        " * You may not use this file except in compliance with the License.\n"
+        " * A copy of the License is located at\n"
+        " *\n"
+        " *  http://aws.amazon.com/apache2.0\n"
+        " *\n"
+        " * or in the \"license\" file accompanying this file. This file is "
         "distributed\n"
-        "* on an \"AS IS\" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY "
+        " * on an \"AS IS\" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY "
         "KIND, either\n"
-        "* express or implied. See the License for the specific language "
+        " * express or implied. See the License for the specific language "
         "governing\n"
-        "* permissions and limitations under the License.\n"
-        "*/\n"
+        " * permissions and limitations under the License.\n"
+        " */\n"
         "\n"
         "/* WARNING: THIS FILE WAS AUTOMATICALLY GENERATED. DO NOT EDIT. */\n"
         "/* clang-format off */\n"
         "\n"
+        "#include <aws/compression/error.h>\n"
         "#include <aws/compression/huffman.h>\n"
+        "#include <aws/compression/huffman_static_coder.h>\n"
         "\n"
-        "static struct aws_huffman_code code_points[] = {\n");
+        "#include <aws/common/byte_order.h>\n"
+        "#include <aws/common/error.h>\n"
+        "\n"
+        "#include <string.h>\n"
+        "\n");
+
+    /* Codes too long to pack are left as 0, which sends encoding back to encode_symbol */
+
+    fprintf(file, "static const uint32_t packed_codes[] = {\n");
 
     for (size_t i = 0; i < num_code_points; ++i) {
         struct huffman_code_point *cp = &code_points[i];
+        uint32_t packed = 0;
+        if (cp->code.num_bits && cp->code.num_bits <= packed_max_code_length) {
+            packed = (1u << cp->code.num_bits) | cp->code.bits;
+        }
         fprintf(
             file,
-            "    { .pattern = 0x%x, .num_bits = %u }, /* '%c' %u */\n",
-            cp->code.bits,
-            cp->code.num_bits,
+            "    0x%x, /* '%c' %u */\n",
+            packed,
             isprint(cp->symbol) ? cp->symbol : ' ',
             cp->symbol);
     }
 
+    fprintf(file, "};\n\n");
+
+    fprintf(file, "static const uint8_t code_lengths[] = {\n");
+
+    for (size_t i = 0; i < num_code_points; ++i) {
+        if (i % 16 == 0) {
+            fprintf(file, "    ");
+        }
+        fprintf(file, "%u,", code_points[i].code.num_bits);
+        fprintf(file, (i % 16 == 15 || i + 1 == num_code_points) ? "\n" : " ");
+    }
+
     fprintf(
         file,
         "};\n"
         "\n"
         "static struct aws_huffman_code encode_symbol(uint8_t symbol, void "
         "*userdata) {\n"
-        "    (void)userdata;\n\n"
-        "    return code_points[symbol];\n"
-        "}\n"
-        "\n"
-        "/* NOLINTNEXTLINE(readability-function-size) */\n"
-        "static uint8_t decode_symbol(uint32_t bits, uint8_t *symbol, void "
-        "*userdata) {\n"
         "    (void)userdata;\n\n");
 
-    /* Traverse the tree */
-    huffman_node_write_decode(&tree_root, file, 0);
+    fprintf(
+        file,
+        "    struct aws_huffman_code code_point = {0};\n"
+        "    const uint32_t packed = packed_codes[symbol];\n"
+        "    if (packed) {\n"
+        "        code_point.num_bits = AWS_HUFFMAN_PACKED_NUM_BITS(packed);\n"
+        "        code_point.pattern = AWS_HUFFMAN_PACKED_PATTERN(packed, code_point.num_bits);\n"
+        "    }\n");
+
+    /* The only codes that don't pack are 32 bits long, spell those out instead of keeping a second table */
+    if (max_code_length > packed_max_code_length) {
+        fprintf(file, "\n    switch (symbol) {\n");
+        for (size_t i = 0; i < num_code_points; ++i) {
+            struct huffman_code_point *cp = &code_points[i];
+            if (cp->code.num_bits > packed_max_code_length) {
+                fprintf(
+                    file,
+                    "        case %u:\n"
+                    "            code_point.pattern = 0x%x;\n"
+                    "            code_point.num_bits = %u;\n"
+                    "            break;\n",
+                    cp->symbol,
+                    cp->code.bits,
+                    cp->code.num_bits);
+            }
+        }
+        fprintf(file, "    }\n");
+    }
+
+    fprintf(file, "    return code_point;\n");
+
+    fprintf(file, "}\n\n");
+
+    if (decoder_type == DECODER_TABLE || decoder_type == DECODER_MULTI) {
+        decode_table_write(&tree_root, file);
+        if (decoder_type == DECODER_MULTI) {
+            multi_decode_table_write(&tree_root, file);
+        }
+        decode_buffer_write(file, decoder_type);
+    } else if (decoder_type == DECODER_CANONICAL) {
+        if (canonical_decoder_write(file)) {
+            fclose(file);
+            remove(output_file);
+            return 1;
+        }
+        decode_buffer_write(file, decoder_type);
+    } else {
+        fprintf(
+            file,
+            "/* NOLINTNEXTLINE(readability-function-size) */\n"
+            "static uint8_t decode_symbol(uint32_t bits, uint8_t *symbol, void "
+            "*userdata) {\n"
+            "    (void)userdata;\n\n");
+
+        /* Traverse the tree */
+        huffman_node_write_decode(&tree_root, file, 0);
 
-    /* Write the function footer & encode header */
+        fprintf(file, "}\n");
+        decode_buffer_write(file, decoder_type);
+    }
+
+    /* Write the coder getter */
     fprintf(
         file,
-        "}\n"
         "\n"
         "struct aws_huffman_symbol_coder *%s_get_coder(void) {\n"
         "\n"
         "    static struct aws_huffman_symbol_coder coder = {\n"
         "        .encode = encode_symbol,\n"
         "        .decode = decode_symbol,\n"
+        "%s"
+        "        .decode_buffer = decode_buffer,\n"
         "        .userdata = NULL,\n"
+        "        .code_lengths = code_lengths,\n"
+        "        .min_code_length = %u,\n"
+        "        .max_code_length = %u,\n"
+        "        .packed_codes = packed_codes,\n"
         "    };\n"
         "    return &coder;\n"
-        "}\n",
+        "}\n"
+        "\n"
+        "AWS_HUFFMAN_DEFINE_STATIC_CODER(%s, packed_codes, decode_buffer)\n",
+        decoder_name,
+        decoder_type == DECODER_MULTI ? "        .decode_multi = decode_symbols,\n" : "",
+        min_code_length,
+        max_code_length,
         decoder_name);
 
     fclose(file);
 
     huffman_node_clean_up(&tree_root);
 
+    /* 4 bytes per symbol for packed_codes and 1 for code_lengths */
+    const size_t encode_footprint = num_code_points * sizeof(uint32_t) + num_code_points;
+    if (decoder_type == DECODER_TREE) {
+        /* The tree is code rather than data, so there's no table size to report */
+        printf(
+            "%s: no decode tables (%zu branches of generated code), %zu bytes of encode tables\n",
+            decoder_name,
+            decode_tree_branches,
+            encode_footprint);
+    } else {
+        printf(
+            "%s: %zu bytes of decode tables, %zu bytes of encode tables\n",
+            decoder_name,
+            decode_footprint,
+            encode_footprint);
+    }
+
     return 0;
 }
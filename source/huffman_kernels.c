@@ -0,0 +1,93 @@
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/compression/huffman.h>
+
+#include <aws/compression/private/huffman_kernels.h>
+
+#include <aws/common/atomics.h>
+#include <aws/common/cpuid.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+static struct aws_huffman_kernels s_scalar_kernels = {
+    .name = "scalar",
+    .sum_code_lengths = aws_huffman_sum_code_lengths_scalar,
+    .count_symbols = aws_huffman_count_symbols_scalar,
+};
+
+#ifdef AWS_COMPRESSION_HAVE_INTEL_SIMD
+static size_t s_sum_code_lengths_avx2(const uint8_t *code_lengths, const uint8_t *input, size_t len) {
+
+    /* Below 64 bytes, setting up the vector tables costs more than it saves */
+    if (len < 64) {
+        return aws_huffman_sum_code_lengths_scalar(code_lengths, input, len);
+    }
+
+    return aws_huffman_sum_code_lengths_avx2(code_lengths, input, len);
+}
+
+/* Byte histograms gather and scatter, which AVX2 doesn't speed up, so counting stays scalar */
+static struct aws_huffman_kernels s_avx2_kernels = {
+    .name = "avx2",
+    .sum_code_lengths = s_sum_code_lengths_avx2,
+    .count_symbols = aws_huffman_count_symbols_scalar,
+};
+#endif
+
+/* NULL until the first call to aws_huffman_get_kernels or aws_huffman_force_scalar_kernels */
+static struct aws_atomic_var s_kernels = AWS_ATOMIC_INIT_PTR(NULL);
+
+static struct aws_huffman_kernels *s_select_kernels(bool force_scalar) {
+
+#ifdef AWS_COMPRESSION_HAVE_INTEL_SIMD
+    if (!force_scalar && aws_cpu_has_feature(AWS_CPU_FEATURE_AVX2)) {
+        return &s_avx2_kernels;
+    }
+#else
+    (void)force_scalar;
+#endif
+
+    return &s_scalar_kernels;
+}
+
+const struct aws_huffman_kernels *aws_huffman_get_kernels(void) {
+
+    struct aws_huffman_kernels *kernels = aws_atomic_load_ptr_explicit(&s_kernels, aws_memory_order_acquire);
+    if (kernels) {
+        return kernels;
+    }
+
+    /* Any value other than empty or "0" forces the scalar kernels */
+    const char *force_scalar = getenv("AWS_COMPRESSION_FORCE_SCALAR");
+    kernels = s_select_kernels(force_scalar && *force_scalar && strcmp(force_scalar, "0") != 0);
+
+    /* If another thread got here first, or the kernels were forced meanwhile, use its choice */
+    void *expected = NULL;
+    if (!aws_atomic_compare_exchange_ptr(&s_kernels, &expected, kernels)) {
+        kernels = expected;
+    }
+
+    return kernels;
+}
+
+void aws_huffman_force_scalar_kernels(bool force_scalar) {
+    aws_atomic_store_ptr(&s_kernels, s_select_kernels(force_scalar));
+}
+
+const char *aws_huffman_get_kernels_name(void) {
+    return aws_huffman_get_kernels()->name;
+}
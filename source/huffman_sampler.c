@@ -0,0 +1,147 @@
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/compression/huffman.h>
+
+#include <aws/compression/private/huffman_kernels.h>
+
+#include <math.h>
+
+void aws_huffman_sampler_init(struct aws_huffman_sampler *sampler, size_t period) {
+
+    AWS_PRECONDITION(sampler);
+
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(sampler->counts); ++i) {
+        aws_atomic_init_int(&sampler->counts[i], 0);
+    }
+    sampler->period = period ? period : 1;
+    sampler->next_offset = 0;
+}
+
+void aws_huffman_sampler_sample(struct aws_huffman_sampler *sampler, struct aws_byte_cursor symbols) {
+
+    AWS_PRECONDITION(sampler);
+
+    size_t i = sampler->next_offset;
+    for (; i < symbols.len; i += sampler->period) {
+        /* Only this thread writes, so a relaxed load and store is enough */
+        struct aws_atomic_var *count = &sampler->counts[symbols.ptr[i]];
+        aws_atomic_store_int_explicit(
+            count, aws_atomic_load_int_explicit(count, aws_memory_order_relaxed) + 1, aws_memory_order_relaxed);
+    }
+    sampler->next_offset = i - symbols.len;
+}
+
+void aws_huffman_histogram_init(struct aws_huffman_histogram *histogram) {
+
+    AWS_PRECONDITION(histogram);
+
+    AWS_ZERO_STRUCT(*histogram);
+}
+
+void aws_huffman_count_symbols_scalar(uint64_t *counts, const uint8_t *input, size_t len) {
+
+    /* Runs of the same byte would wait on each increment, so spread consecutive bytes over 4 sets of counts */
+    uint64_t partial_counts[4][256];
+    AWS_ZERO_ARRAY(partial_counts);
+
+    size_t i = 0;
+    for (; i + 4 <= len; i += 4) {
+        ++partial_counts[0][input[i]];
+        ++partial_counts[1][input[i + 1]];
+        ++partial_counts[2][input[i + 2]];
+        ++partial_counts[3][input[i + 3]];
+    }
+    for (; i < len; ++i) {
+        ++partial_counts[0][input[i]];
+    }
+
+    for (size_t symbol = 0; symbol < 256; ++symbol) {
+        counts[symbol] += partial_counts[0][symbol] + partial_counts[1][symbol] + partial_counts[2][symbol] +
+                          partial_counts[3][symbol];
+    }
+}
+
+void aws_huffman_histogram_add_symbols(struct aws_huffman_histogram *histogram, struct aws_byte_cursor symbols) {
+
+    AWS_PRECONDITION(histogram);
+
+    if (symbols.len) {
+        aws_huffman_get_kernels()->count_symbols(histogram->counts, symbols.ptr, symbols.len);
+    }
+}
+
+void aws_huffman_histogram_add_sampler(
+    struct aws_huffman_histogram *histogram,
+    const struct aws_huffman_sampler *sampler) {
+
+    AWS_PRECONDITION(histogram);
+    AWS_PRECONDITION(sampler);
+
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(histogram->counts); ++i) {
+        histogram->counts[i] += aws_atomic_load_int_explicit(&sampler->counts[i], aws_memory_order_relaxed);
+    }
+}
+
+void aws_huffman_histogram_merge(struct aws_huffman_histogram *histogram, const struct aws_huffman_histogram *other) {
+
+    AWS_PRECONDITION(histogram);
+    AWS_PRECONDITION(other);
+
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(histogram->counts); ++i) {
+        histogram->counts[i] += other->counts[i];
+    }
+}
+
+int aws_huffman_histogram_report(
+    const struct aws_huffman_histogram *histogram,
+    struct aws_huffman_symbol_coder *coder,
+    struct aws_huffman_entropy_report *report) {
+
+    AWS_PRECONDITION(histogram);
+    AWS_PRECONDITION(coder);
+    AWS_PRECONDITION(report);
+
+    AWS_ZERO_STRUCT(*report);
+
+    uint8_t optimal_lengths[256];
+    if (aws_huffman_code_lengths_from_frequencies(histogram->counts, 32, optimal_lengths)) {
+        return AWS_OP_ERR;
+    }
+
+    uint64_t coder_bits = 0;
+    uint64_t optimal_bits = 0;
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(histogram->counts); ++i) {
+        report->num_symbols += histogram->counts[i];
+
+        const uint8_t code_length =
+            coder->code_lengths ? coder->code_lengths[i] : coder->encode((uint8_t)i, coder->userdata).num_bits;
+        coder_bits += histogram->counts[i] * code_length;
+        optimal_bits += histogram->counts[i] * optimal_lengths[i];
+    }
+
+    const double num_symbols = (double)report->num_symbols;
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(histogram->counts); ++i) {
+        if (histogram->counts[i]) {
+            const double probability = (double)histogram->counts[i] / num_symbols;
+            report->entropy -= probability * log2(probability);
+        }
+    }
+
+    report->coder_bits = (double)coder_bits / num_symbols;
+    report->optimal_bits = (double)optimal_bits / num_symbols;
+
+    return AWS_OP_SUCCESS;
+}
@@ -0,0 +1,244 @@
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/compression/huffman.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+enum { num_symbols = 256 };
+
+/* Longest code allowed by default. Short enough for the table decoders to stay small */
+static const uint8_t default_max_bits = 12;
+
+struct file_stats {
+    uint64_t num_bytes;
+    uint64_t num_bits;
+};
+
+/* Reads a whole file, adding each byte to histogram (if not NULL) and its code length (if not NULL) to stats */
+static int read_sample_file(
+    const char *path,
+    struct aws_huffman_histogram *histogram,
+    const uint8_t *code_lengths,
+    struct file_stats *stats) {
+
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        fprintf(stderr, "Failed to open file '%s' for read.\n", path);
+        return 1;
+    }
+
+    uint8_t buffer[4096];
+    size_t num_read = 0;
+    while ((num_read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        if (histogram) {
+            aws_huffman_histogram_add_symbols(histogram, aws_byte_cursor_from_array(buffer, num_read));
+        }
+        if (code_lengths) {
+            for (size_t i = 0; i < num_read; ++i) {
+                stats->num_bits += code_lengths[buffer[i]];
+            }
+        }
+        stats->num_bytes += num_read;
+    }
+
+    int failed = ferror(file);
+    fclose(file);
+
+    if (failed) {
+        fprintf(stderr, "Failed to read file '%s'.\n", path);
+        return 1;
+    }
+
+    return 0;
+}
+
+static void print_stats(const char *name, const struct file_stats *stats) {
+
+    const double bits_per_byte = stats->num_bytes ? (double)stats->num_bits / (double)stats->num_bytes : 0.0;
+    printf(
+        "%-40s %12llu bytes %8.3f bits/byte\n", name, (unsigned long long)stats->num_bytes, bits_per_byte);
+}
+
+static int write_code_points(const char *output_path, const struct aws_huffman_code *codes, uint8_t max_code_length) {
+
+    FILE *file = fopen(output_path, "w");
+    if (!file) {
+        fprintf(stderr, "Failed to open file '%s' for write.\n", output_path);
+        return 1;
+    }
+
+    fprintf(
+        file,
+        "/*\n"
+        " * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.\n"
+        " *\n"
+        " * Licensed under the Apache License, Version 2.0 (the \"License\").\n"
+        " * You may not use this file except in compliance with the License.\n"
+        " * A copy of the License is located at\n"
+        " *\n"
+        " *  http://aws.amazon.com/apache2.0\n"
+        " *\n"
+        " * or in the \"license\" file accompanying this file. This file is distributed\n"
+        " * on an \"AS IS\" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either\n"
+        " * express or implied. See the License for the specific language governing\n"
+        " * permissions and limitations under the License.\n"
+        " */\n"
+        "\n"
+        "/* WARNING: THIS FILE WAS AUTOMATICALLY GENERATED. DO NOT EDIT. */\n"
+        "\n"
+        "#ifndef HUFFMAN_CODE\n"
+        "#error \"Macro HUFFMAN_CODE must be defined before including this header file!\"\n"
+        "#endif\n"
+        "\n");
+
+    /* Line the columns up like the hand written tables */
+    const int bits_width = max_code_length + 2 > 17 ? max_code_length + 2 : 17;
+    const int hex_width = 2 + (max_code_length + 3) / 4;
+
+    fprintf(file, "/*           sym %*s   code len */\n", bits_width - 3, "bits");
+
+    for (size_t symbol = 0; symbol < num_symbols; ++symbol) {
+        const struct aws_huffman_code *code = &codes[symbol];
+
+        char bits[2 + 32 + 1];
+        size_t bits_len = 0;
+        bits[bits_len++] = '"';
+        for (int bit_idx = code->num_bits - 1; bit_idx >= 0; --bit_idx) {
+            bits[bits_len++] = ((code->pattern >> bit_idx) & 0x1) ? '1' : '0';
+        }
+        bits[bits_len++] = '"';
+        bits[bits_len] = '\0';
+
+        char hex[2 + 8 + 1];
+        snprintf(hex, sizeof(hex), "0x%x", (unsigned)code->pattern);
+
+        fprintf(
+            file,
+            "HUFFMAN_CODE(%3u, %*s, %*s, %2u)\n",
+            (unsigned)symbol,
+            bits_width,
+            bits,
+            hex_width,
+            hex,
+            (unsigned)code->num_bits);
+    }
+
+    fclose(file);
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+
+    if (argc < 3) {
+        fprintf(
+            stderr,
+            "trainer expects at least 2 arguments: [output file] [training files...] [options]\n"
+            "Writes a table definition file for the huffman generator, with the shortest\n"
+            "codes for the bytes that are most common in the training files. Every byte\n"
+            "value gets a code, so anything can still be encoded.\n"
+            "Options:\n"
+            "  --max-bits=N       Longest code allowed, from 8 to 32 (default %u)\n"
+            "  --held-out=FILE    Also report the bits per byte for FILE, which is not trained on\n",
+            (unsigned)default_max_bits);
+        return 1;
+    }
+
+    const char *output_file = argv[1];
+
+    uint8_t max_code_length = default_max_bits;
+    const char **training_files = calloc((size_t)argc, sizeof(const char *));
+    const char **held_out_files = calloc((size_t)argc, sizeof(const char *));
+    size_t num_training_files = 0;
+    size_t num_held_out_files = 0;
+    int result = 1;
+
+    if (!training_files || !held_out_files) {
+        fprintf(stderr, "Out of memory.\n");
+        goto cleanup;
+    }
+
+    for (int i = 2; i < argc; ++i) {
+        if (strncmp(argv[i], "--max-bits=", 11) == 0) {
+            const long max_bits = strtol(argv[i] + 11, NULL, 10);
+            if (max_bits < 8 || max_bits > 32) {
+                fprintf(stderr, "--max-bits must be from 8 to 32\n");
+                goto cleanup;
+            }
+            max_code_length = (uint8_t)max_bits;
+        } else if (strncmp(argv[i], "--held-out=", 11) == 0) {
+            held_out_files[num_held_out_files++] = argv[i] + 11;
+        } else if (strncmp(argv[i], "--", 2) == 0) {
+            fprintf(stderr, "Unknown option '%s'\n", argv[i]);
+            goto cleanup;
+        } else {
+            training_files[num_training_files++] = argv[i];
+        }
+    }
+
+    if (num_training_files == 0) {
+        fprintf(stderr, "No training files given\n");
+        goto cleanup;
+    }
+
+    /* Start every count at 1, so bytes that weren't seen in training still get a code */
+    struct aws_huffman_histogram histogram;
+    for (size_t i = 0; i < num_symbols; ++i) {
+        histogram.counts[i] = 1;
+    }
+    const uint64_t *frequencies = histogram.counts;
+
+    struct file_stats training_stats = {0, 0};
+    for (size_t i = 0; i < num_training_files; ++i) {
+        if (read_sample_file(training_files[i], &histogram, NULL, &training_stats)) {
+            goto cleanup;
+        }
+    }
+
+    uint8_t code_lengths[num_symbols];
+    struct aws_huffman_code codes[num_symbols];
+    if (aws_huffman_code_lengths_from_frequencies(frequencies, max_code_length, code_lengths) ||
+        aws_huffman_assign_canonical_codes(code_lengths, codes)) {
+        fprintf(stderr, "Failed to build a code from the training files\n");
+        goto cleanup;
+    }
+
+    for (size_t i = 0; i < num_symbols; ++i) {
+        training_stats.num_bits += (frequencies[i] - 1) * code_lengths[i];
+    }
+
+    if (write_code_points(output_file, codes, max_code_length)) {
+        goto cleanup;
+    }
+
+    print_stats("training", &training_stats);
+
+    for (size_t i = 0; i < num_held_out_files; ++i) {
+        struct file_stats held_out_stats = {0, 0};
+        if (read_sample_file(held_out_files[i], NULL, code_lengths, &held_out_stats)) {
+            goto cleanup;
+        }
+        print_stats(held_out_files[i], &held_out_stats);
+    }
+
+    result = 0;
+
+cleanup:
+    free(training_files);
+    free(held_out_files);
+    return result;
+}
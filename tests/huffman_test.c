@@ -16,10 +16,17 @@
 #include <aws/testing/aws_test_harness.h>
 #include <aws/testing/compression/huffman.h>
 
+#include <aws/compression/error.h>
 #include <aws/compression/huffman.h>
+#include <aws/compression/huffman_static_coder.h>
 
-/* Exported by generated file */
-struct aws_huffman_symbol_coder *test_get_coder(void);
+/* Exported by generated files */
+AWS_HUFFMAN_DECLARE_STATIC_CODER(test);
+AWS_HUFFMAN_DECLARE_STATIC_CODER(test_table);
+AWS_HUFFMAN_DECLARE_STATIC_CODER(test_multi);
+AWS_HUFFMAN_DECLARE_STATIC_CODER(test_canonical);
+AWS_HUFFMAN_DECLARE_STATIC_CODER(test_small_table);
+AWS_HUFFMAN_DECLARE_STATIC_CODER(test_long_codes);
 
 static struct huffman_test_code_point s_code_points[] = {
 #include "test_huffman_static_table.def"
@@ -69,6 +76,112 @@ static int test_huffman_symbol_encoder(struct aws_allocator *allocator, void *ct
     return AWS_OP_SUCCESS;
 }
 
+static int s_test_coder_metadata(struct aws_huffman_symbol_coder *coder) {
+
+    ASSERT_NOT_NULL(coder->code_lengths);
+
+    uint8_t min_code_length = UINT8_MAX;
+    uint8_t max_code_length = 0;
+    for (size_t i = 0; i < NUM_CODE_POINTS; ++i) {
+        struct huffman_test_code_point *value = &s_code_points[i];
+
+        ASSERT_UINT_EQUALS(value->code.num_bits, coder->code_lengths[value->symbol]);
+
+        if (value->code.num_bits < min_code_length) {
+            min_code_length = value->code.num_bits;
+        }
+        if (value->code.num_bits > max_code_length) {
+            max_code_length = value->code.num_bits;
+        }
+    }
+
+    ASSERT_UINT_EQUALS(min_code_length, coder->min_code_length);
+    ASSERT_UINT_EQUALS(max_code_length, coder->max_code_length);
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(huffman_coder_metadata, test_huffman_coder_metadata)
+static int test_huffman_coder_metadata(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+    /* Test that the generated code lengths match the table, and that the
+     * encoded length is the same whether or not they are used */
+
+    ASSERT_SUCCESS(s_test_coder_metadata(test_get_coder()));
+    ASSERT_SUCCESS(s_test_coder_metadata(test_table_get_coder()));
+    ASSERT_SUCCESS(s_test_coder_metadata(test_multi_get_coder()));
+
+    struct aws_huffman_symbol_coder coder = *test_get_coder();
+    coder.code_lengths = NULL;
+    coder.min_code_length = 0;
+    coder.max_code_length = 0;
+
+    struct aws_huffman_encoder encoder;
+    aws_huffman_encoder_init(&encoder, &coder);
+
+    struct aws_byte_cursor to_encode = aws_byte_cursor_from_array(s_all_codes, ALL_CODES_LEN);
+    ASSERT_UINT_EQUALS(ENCODED_CODES_LEN, aws_huffman_get_encoded_length(&encoder, to_encode));
+
+    return AWS_OP_SUCCESS;
+}
+
+static size_t s_num_encode_calls = 0;
+
+/* Counts calls to the test coder's encode */
+static struct aws_huffman_code s_counting_encode(uint8_t symbol, void *userdata) {
+    (void)userdata;
+    ++s_num_encode_calls;
+    return test_get_coder()->encode(symbol, NULL);
+}
+
+AWS_TEST_CASE(huffman_encoded_length, test_huffman_encoded_length)
+static int test_huffman_encoded_length(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+    /* Test the encoded length of every byte value, at lengths on either side of
+     * the vectorized paths, with and without generated code lengths */
+
+    uint8_t input[600];
+    for (size_t i = 0; i < sizeof(input); ++i) {
+        input[i] = (uint8_t)(i * 167 + (i >> 8));
+    }
+
+    struct aws_huffman_symbol_coder *coder = test_get_coder();
+    struct aws_huffman_symbol_coder probed_coder = *coder;
+    probed_coder.encode = s_counting_encode;
+    probed_coder.code_lengths = NULL;
+    probed_coder.packed_codes = NULL;
+    s_num_encode_calls = 0;
+
+    struct aws_huffman_encoder encoder;
+    aws_huffman_encoder_init(&encoder, coder);
+    struct aws_huffman_encoder probed_encoder;
+    aws_huffman_encoder_init(&probed_encoder, &probed_coder);
+
+    size_t num_bits = 0;
+    for (size_t len = 1; len <= sizeof(input); ++len) {
+        num_bits += coder->encode(input[len - 1], NULL).num_bits;
+        const size_t expected_length = (num_bits + 7) / 8;
+
+        struct aws_byte_cursor to_encode = aws_byte_cursor_from_array(input, len);
+        ASSERT_UINT_EQUALS(expected_length, aws_huffman_get_encoded_length(&encoder, to_encode));
+        ASSERT_UINT_EQUALS(expected_length, aws_huffman_get_encoded_length(&probed_encoder, to_encode));
+    }
+
+    /* Inputs up to 256 bytes call encode per byte, then every symbol is probed once for all the longer inputs */
+    ASSERT_UINT_EQUALS(256 * 257 / 2 + 256, s_num_encode_calls);
+
+    /* The probed lengths are kept across reset, and used for short inputs too */
+    aws_huffman_encoder_reset(&probed_encoder);
+    ASSERT_UINT_EQUALS(
+        aws_huffman_get_encoded_length(&encoder, aws_byte_cursor_from_array(input, 10)),
+        aws_huffman_get_encoded_length(&probed_encoder, aws_byte_cursor_from_array(input, 10)));
+    ASSERT_UINT_EQUALS(256 * 257 / 2 + 256, s_num_encode_calls);
+
+    return AWS_OP_SUCCESS;
+}
+
 AWS_TEST_CASE(huffman_encoder, test_huffman_encoder)
 static int test_huffman_encoder(struct aws_allocator *allocator, void *ctx) {
     (void)allocator;
@@ -174,13 +287,344 @@ static int test_huffman_encoder_partial_output(struct aws_allocator *allocator,
     return AWS_OP_SUCCESS;
 }
 
-AWS_TEST_CASE(huffman_symbol_decoder, test_huffman_symbol_decoder)
-static int test_huffman_symbol_decoder(struct aws_allocator *allocator, void *ctx) {
+AWS_TEST_CASE(huffman_encoder_update, test_huffman_encoder_update)
+static int test_huffman_encoder_update(struct aws_allocator *allocator, void *ctx) {
     (void)allocator;
     (void)ctx;
-    /* Test decoding each character */
+    /* Test encoding one string fed in pieces, with limited output, matches encoding it whole */
+
+    struct aws_huffman_encoder encoder;
+    aws_huffman_encoder_init(&encoder, test_get_coder());
+
+    uint8_t output_buffer[ENCODED_CODES_LEN + 1];
+
+    for (size_t i = 0; i < NUM_STEP_SIZES; ++i) {
+        const size_t step_size = s_step_sizes[i];
+
+        aws_huffman_encoder_reset(&encoder);
+
+        struct aws_byte_buf output_buf = aws_byte_buf_from_empty_array(output_buffer, ENCODED_CODES_LEN);
+        AWS_ZERO_ARRAY(output_buffer);
+
+        /* Pieces of step_size symbols, with output_buf growing by step_size bytes whenever it fills */
+        output_buf.capacity = step_size < ENCODED_CODES_LEN ? step_size : ENCODED_CODES_LEN;
+        for (size_t offset = 0; offset < ALL_CODES_LEN; offset += step_size) {
+            const size_t piece_len = ALL_CODES_LEN - offset < step_size ? ALL_CODES_LEN - offset : step_size;
+            struct aws_byte_cursor to_encode = aws_byte_cursor_from_array(s_all_codes + offset, piece_len);
+
+            while (aws_huffman_encode_update(&encoder, &to_encode, &output_buf)) {
+                ASSERT_UINT_EQUALS(AWS_ERROR_SHORT_BUFFER, aws_last_error());
+                aws_reset_error();
+                ASSERT_TRUE(output_buf.capacity < ENCODED_CODES_LEN);
+                output_buf.capacity += step_size;
+                if (output_buf.capacity > ENCODED_CODES_LEN) {
+                    output_buf.capacity = ENCODED_CODES_LEN;
+                }
+            }
+            ASSERT_UINT_EQUALS(0, to_encode.len);
+            ASSERT_BIN_ARRAYS_EQUALS(s_encoded_codes, output_buf.len, output_buf.buffer, output_buf.len);
+        }
+
+        /* The final partial byte is only written by finish */
+        ASSERT_UINT_EQUALS(ENCODED_CODES_LEN - 1, output_buf.len);
+        output_buf.capacity = output_buf.len;
+        ASSERT_ERROR(AWS_ERROR_SHORT_BUFFER, aws_huffman_encode_finish(&encoder, &output_buf));
+        output_buf.capacity = ENCODED_CODES_LEN;
+        ASSERT_SUCCESS(aws_huffman_encode_finish(&encoder, &output_buf));
+
+        ASSERT_UINT_EQUALS(0, output_buffer[ENCODED_CODES_LEN]);
+        ASSERT_BIN_ARRAYS_EQUALS(s_encoded_codes, ENCODED_CODES_LEN, output_buf.buffer, output_buf.len);
+
+        /* Nothing left to pad */
+        ASSERT_SUCCESS(aws_huffman_encode_finish(&encoder, &output_buf));
+        ASSERT_UINT_EQUALS(ENCODED_CODES_LEN, output_buf.len);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(huffman_encoder_in_place, test_huffman_encoder_in_place)
+static int test_huffman_encoder_in_place(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+    /* Test encoding over the symbols, and refusing when writing would pass reading */
+
+    struct aws_huffman_encoder encoder;
+    aws_huffman_encoder_init(&encoder, test_get_coder());
+
+    char url_buffer[URL_STRING_LEN];
+    memcpy(url_buffer, s_url_string, URL_STRING_LEN);
+    struct aws_byte_buf buf = aws_byte_buf_from_array(url_buffer, URL_STRING_LEN);
+    ASSERT_SUCCESS(aws_huffman_encode_in_place(&encoder, &buf));
+    ASSERT_BIN_ARRAYS_EQUALS(s_encoded_url, ENCODED_URL_LEN, buf.buffer, buf.len);
+
+    /* The encoding is longer than the symbols */
+    char all_codes_buffer[ALL_CODES_LEN];
+    memcpy(all_codes_buffer, s_all_codes, ALL_CODES_LEN);
+    buf = aws_byte_buf_from_array(all_codes_buffer, ALL_CODES_LEN);
+    aws_huffman_encoder_reset(&encoder);
+    ASSERT_ERROR(AWS_ERROR_SHORT_BUFFER, aws_huffman_encode_in_place(&encoder, &buf));
+    ASSERT_BIN_ARRAYS_EQUALS(s_all_codes, ALL_CODES_LEN, buf.buffer, buf.len);
+
+    /* The encoding fits, but four 10 bit codes would be written over the first 'a' before it is read */
+    const char overtaking[] = "\0\0\0\0aaa";
+    char overtaking_buffer[sizeof(overtaking) - 1];
+    memcpy(overtaking_buffer, overtaking, sizeof(overtaking_buffer));
+    buf = aws_byte_buf_from_array(overtaking_buffer, sizeof(overtaking_buffer));
+    aws_huffman_encoder_reset(&encoder);
+    ASSERT_TRUE(aws_huffman_get_encoded_length(&encoder, aws_byte_cursor_from_buf(&buf)) <= buf.len);
+    ASSERT_ERROR(AWS_ERROR_SHORT_BUFFER, aws_huffman_encode_in_place(&encoder, &buf));
+    ASSERT_BIN_ARRAYS_EQUALS(overtaking, sizeof(overtaking_buffer), buf.buffer, buf.len);
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(huffman_status, test_huffman_status)
+static int test_huffman_status(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+    /* Test the status returned by each step, and that only real errors are raised */
+
+    aws_reset_error();
+
+    struct aws_huffman_encoder encoder;
+    aws_huffman_encoder_init(&encoder, test_get_coder());
+
+    uint8_t encoded_buffer[ENCODED_CODES_LEN];
+    struct aws_byte_buf encoded_buf = aws_byte_buf_from_empty_array(encoded_buffer, 4);
+
+    struct aws_byte_cursor to_encode = aws_byte_cursor_from_array(s_all_codes, ALL_CODES_LEN);
+    ASSERT_INT_EQUALS(AWS_HUFFMAN_NEED_OUTPUT, aws_huffman_encode_step(&encoder, &to_encode, &encoded_buf, false));
+    ASSERT_UINT_EQUALS(4, encoded_buf.len);
+    ASSERT_INT_EQUALS(AWS_HUFFMAN_NEED_OUTPUT, aws_huffman_encode_step(&encoder, &to_encode, &encoded_buf, false));
+
+    encoded_buf.capacity = ENCODED_CODES_LEN;
+    ASSERT_INT_EQUALS(AWS_HUFFMAN_NEED_INPUT, aws_huffman_encode_step(&encoder, &to_encode, &encoded_buf, false));
+    ASSERT_UINT_EQUALS(0, to_encode.len);
+    ASSERT_INT_EQUALS(AWS_HUFFMAN_DONE, aws_huffman_encode_step(&encoder, &to_encode, &encoded_buf, true));
+    ASSERT_BIN_ARRAYS_EQUALS(s_encoded_codes, ENCODED_CODES_LEN, encoded_buf.buffer, encoded_buf.len);
+    ASSERT_INT_EQUALS(AWS_ERROR_SUCCESS, aws_last_error());
+
+    struct aws_huffman_symbol_coder *coders[] = {test_get_coder(), test_table_get_coder(), test_multi_get_coder()};
+
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(coders); ++i) {
+        struct aws_huffman_decoder decoder;
+        aws_huffman_decoder_init(&decoder, coders[i]);
+
+        char decoded_buffer[ALL_CODES_LEN];
+        struct aws_byte_buf decoded_buf = aws_byte_buf_from_empty_array(decoded_buffer, 4);
+
+        struct aws_byte_cursor to_decode = aws_byte_cursor_from_array(s_encoded_codes, ENCODED_CODES_LEN);
+        ASSERT_INT_EQUALS(AWS_HUFFMAN_NEED_OUTPUT, aws_huffman_decode_step(&decoder, &to_decode, &decoded_buf));
+        ASSERT_UINT_EQUALS(4, decoded_buf.len);
+
+        decoded_buf.capacity = ALL_CODES_LEN;
+        ASSERT_INT_EQUALS(AWS_HUFFMAN_NEED_INPUT, aws_huffman_decode_step(&decoder, &to_decode, &decoded_buf));
+        ASSERT_UINT_EQUALS(0, to_decode.len);
+        ASSERT_BIN_ARRAYS_EQUALS(s_all_codes, ALL_CODES_LEN, decoded_buf.buffer, decoded_buf.len);
+        ASSERT_INT_EQUALS(AWS_ERROR_SUCCESS, aws_last_error());
+
+        /* ' ' (00100) followed by zeros. No code starts with 0000 */
+        uint8_t unknown_buffer[] = {0x20, 0x00, 0x00, 0x00, 0x00, 0x00};
+        struct aws_byte_cursor unknown = aws_byte_cursor_from_array(unknown_buffer, sizeof(unknown_buffer));
+        aws_huffman_decoder_reset(&decoder);
+        decoded_buf.len = 0;
+        ASSERT_INT_EQUALS(AWS_HUFFMAN_ERROR, aws_huffman_decode_step(&decoder, &unknown, &decoded_buf));
+        ASSERT_INT_EQUALS(AWS_ERROR_COMPRESSION_UNKNOWN_SYMBOL, aws_last_error());
+        aws_reset_error();
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(huffman_stats, test_huffman_stats)
+static int test_huffman_stats(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+    /* Test counting encode calls that run out of output, and a decode call */
+
+    struct aws_huffman_stats stats;
+    aws_huffman_stats_init(&stats);
+    struct aws_huffman_stats_snapshot snapshot;
+
+    struct aws_huffman_encoder encoder;
+    aws_huffman_encoder_init(&encoder, test_get_coder());
+    encoder.stats = &stats;
+    aws_huffman_encoder_reset(&encoder);
+    ASSERT_PTR_EQUALS(&stats, encoder.stats);
+
+    uint8_t output_buffer[ENCODED_CODES_LEN];
+    struct aws_byte_cursor to_encode = aws_byte_cursor_from_array(s_all_codes, ALL_CODES_LEN);
+    struct aws_byte_buf output_buf = aws_byte_buf_from_empty_array(output_buffer, sizeof(output_buffer));
+    output_buf.capacity = 0;
+
+    size_t num_calls = 0;
+    size_t num_carries = 0;
+    size_t num_pending_bits = 0;
+    int result = AWS_OP_ERR;
+    do {
+        output_buf.capacity += 4;
+        result = aws_huffman_encode(&encoder, &to_encode, &output_buf);
+        ++num_calls;
+        if (encoder.overflow_bits.num_bits) {
+            ++num_carries;
+            num_pending_bits += encoder.overflow_bits.num_bits;
+        }
+    } while (result != AWS_OP_SUCCESS);
+
+    aws_huffman_stats_snapshot(&stats, &snapshot);
+    ASSERT_UINT_EQUALS(num_calls, snapshot.num_calls);
+    ASSERT_UINT_EQUALS(ALL_CODES_LEN, snapshot.num_symbols);
+    ASSERT_UINT_EQUALS(ALL_CODES_LEN, snapshot.num_bytes_in);
+    ASSERT_UINT_EQUALS(ENCODED_CODES_LEN, snapshot.num_bytes_out);
+    ASSERT_UINT_EQUALS(num_calls - 1, snapshot.num_short_buffer);
+    ASSERT_UINT_EQUALS(num_carries, snapshot.num_carries);
+    ASSERT_UINT_EQUALS(num_pending_bits, snapshot.num_pending_bits);
+
+    aws_huffman_stats_init(&stats);
+
+    struct aws_huffman_decoder decoder;
+    aws_huffman_decoder_init(&decoder, test_table_get_coder());
+    decoder.stats = &stats;
+    aws_huffman_decoder_reset(&decoder);
+
+    char decoded_buffer[ALL_CODES_LEN];
+    struct aws_byte_cursor to_decode = aws_byte_cursor_from_array(s_encoded_codes, ENCODED_CODES_LEN);
+    struct aws_byte_buf decoded_buf = aws_byte_buf_from_empty_array(decoded_buffer, sizeof(decoded_buffer));
+    ASSERT_SUCCESS(aws_huffman_decode(&decoder, &to_decode, &decoded_buf));
+
+    aws_huffman_stats_snapshot(&stats, &snapshot);
+    ASSERT_UINT_EQUALS(1, snapshot.num_calls);
+    ASSERT_UINT_EQUALS(ALL_CODES_LEN, snapshot.num_symbols);
+    ASSERT_UINT_EQUALS(ENCODED_CODES_LEN, snapshot.num_bytes_in);
+    ASSERT_UINT_EQUALS(ALL_CODES_LEN, snapshot.num_bytes_out);
+    ASSERT_UINT_EQUALS(0, snapshot.num_short_buffer);
+    ASSERT_UINT_EQUALS(decoder.num_bits ? 1 : 0, snapshot.num_carries);
+    ASSERT_UINT_EQUALS(decoder.num_bits, snapshot.num_pending_bits);
+
+    /* A full output buffer counts too */
+    ASSERT_ERROR(AWS_ERROR_SHORT_BUFFER, aws_huffman_decode(&decoder, &to_decode, &decoded_buf));
+    aws_huffman_stats_snapshot(&stats, &snapshot);
+    ASSERT_UINT_EQUALS(2, snapshot.num_calls);
+    ASSERT_UINT_EQUALS(1, snapshot.num_short_buffer);
+
+    /* So does an in place encode that doesn't fit, without reading or writing anything */
+    aws_huffman_stats_init(&stats);
+
+    aws_huffman_encoder_init(&encoder, test_get_coder());
+    encoder.stats = &stats;
+
+    uint8_t in_place_buffer[] = {0, 0, 0, 0, 'a', 'a', 'a'};
+    struct aws_byte_buf in_place_buf = aws_byte_buf_from_array(in_place_buffer, sizeof(in_place_buffer));
+    ASSERT_ERROR(AWS_ERROR_SHORT_BUFFER, aws_huffman_encode_in_place(&encoder, &in_place_buf));
+    ASSERT_UINT_EQUALS(sizeof(in_place_buffer), in_place_buf.len);
+
+    aws_huffman_stats_snapshot(&stats, &snapshot);
+    ASSERT_UINT_EQUALS(1, snapshot.num_calls);
+    ASSERT_UINT_EQUALS(1, snapshot.num_short_buffer);
+    ASSERT_UINT_EQUALS(0, snapshot.num_bytes_in);
+    ASSERT_UINT_EQUALS(0, snapshot.num_bytes_out);
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(huffman_sampler, test_huffman_sampler)
+static int test_huffman_sampler(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+    /* Test sampling every other byte across calls, merging, and the entropy report */
 
+    struct aws_huffman_sampler sampler;
+    aws_huffman_sampler_init(&sampler, 2);
+
+    struct aws_huffman_encoder encoder;
+    aws_huffman_encoder_init(&encoder, test_get_coder());
+    encoder.sampler = &sampler;
+
+    /* "aab" then "bab": every other byte of "aabbab" is 'a', 'b', 'a' */
+    uint8_t output_buffer[16];
+    struct aws_byte_buf output_buf = aws_byte_buf_from_empty_array(output_buffer, sizeof(output_buffer));
+    struct aws_byte_cursor to_encode = aws_byte_cursor_from_c_str("aab");
+    ASSERT_SUCCESS(aws_huffman_encode(&encoder, &to_encode, &output_buf));
+    aws_huffman_encoder_reset(&encoder);
+    ASSERT_PTR_EQUALS(&sampler, encoder.sampler);
+    to_encode = aws_byte_cursor_from_c_str("bab");
+    ASSERT_SUCCESS(aws_huffman_encode(&encoder, &to_encode, &output_buf));
+
+    struct aws_huffman_histogram histogram;
+    aws_huffman_histogram_init(&histogram);
+    aws_huffman_histogram_add_sampler(&histogram, &sampler);
+    ASSERT_UINT_EQUALS(2, histogram.counts['a']);
+    ASSERT_UINT_EQUALS(1, histogram.counts['b']);
+
+    struct aws_huffman_histogram other;
+    aws_huffman_histogram_init(&other);
+    other.counts['b'] = 1;
+    aws_huffman_histogram_merge(&histogram, &other);
+    ASSERT_UINT_EQUALS(2, histogram.counts['b']);
+
+    /* Two equally likely symbols: 1 bit of entropy. The best code that leaves the all 1s code unused for the end
+     * of stream padding gives them 1 and 2 bits */
     struct aws_huffman_symbol_coder *coder = test_get_coder();
+    struct aws_huffman_entropy_report report;
+    ASSERT_SUCCESS(aws_huffman_histogram_report(&histogram, coder, &report));
+    ASSERT_UINT_EQUALS(4, report.num_symbols);
+    ASSERT_TRUE(report.entropy > 0.999 && report.entropy < 1.001);
+    ASSERT_TRUE(report.optimal_bits > 1.499 && report.optimal_bits < 1.501);
+    const double coder_bits = (coder->code_lengths['a'] + coder->code_lengths['b']) / 2.0;
+    ASSERT_TRUE(report.coder_bits > coder_bits - 0.001 && report.coder_bits < coder_bits + 0.001);
+
+    aws_huffman_histogram_init(&histogram);
+    ASSERT_ERROR(AWS_ERROR_INVALID_ARGUMENT, aws_huffman_histogram_report(&histogram, coder, &report));
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(huffman_kernels, test_huffman_kernels)
+static int test_huffman_kernels(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+    /* Test that the scalar kernels can be forced, and give the same results as the detected ones */
+
+    /* Long enough for the wide kernels, and not a multiple of any vector width */
+    uint8_t input[1001];
+    uint32_t state = 1;
+    for (size_t i = 0; i < sizeof(input); ++i) {
+        state = state * 1103515245 + 12345;
+        /* Bias towards a few values, so counts repeat */
+        input[i] = (uint8_t)((state >> 16) % ((state >> 8) % 2 ? 8 : 256));
+    }
+    struct aws_byte_cursor to_count = aws_byte_cursor_from_array(input, sizeof(input));
+
+    struct aws_huffman_histogram expected;
+    aws_huffman_histogram_init(&expected);
+    size_t expected_bits = 0;
+    for (size_t i = 0; i < sizeof(input); ++i) {
+        ++expected.counts[input[i]];
+        expected_bits += test_get_coder()->code_lengths[input[i]];
+    }
+
+    struct aws_huffman_encoder encoder;
+    aws_huffman_encoder_init(&encoder, test_get_coder());
+
+    for (int force_scalar = 1; force_scalar >= 0; --force_scalar) {
+        aws_huffman_force_scalar_kernels(force_scalar);
+        if (force_scalar) {
+            ASSERT_STR_EQUALS("scalar", aws_huffman_get_kernels_name());
+        }
+
+        struct aws_huffman_histogram histogram;
+        aws_huffman_histogram_init(&histogram);
+        aws_huffman_histogram_add_symbols(&histogram, to_count);
+        ASSERT_BIN_ARRAYS_EQUALS(expected.counts, sizeof(expected.counts), histogram.counts, sizeof(histogram.counts));
+
+        ASSERT_UINT_EQUALS((expected_bits + 7) / 8, aws_huffman_get_encoded_length(&encoder, to_count));
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_test_symbol_decoder(struct aws_huffman_symbol_coder *coder) {
 
     for (size_t i = 0; i < NUM_CODE_POINTS; ++i) {
         struct huffman_test_code_point *value = &s_code_points[i];
@@ -188,15 +632,149 @@ static int test_huffman_symbol_decoder(struct aws_allocator *allocator, void *ct
         uint32_t bit_pattern = value->code.pattern << (32 - value->code.num_bits);
 
         uint8_t out;
-        size_t bits_read = coder->decode(bit_pattern, &out, NULL);
+        size_t bits_read = coder->decode(bit_pattern, &out, coder->userdata);
+
+        ASSERT_UINT_EQUALS(value->symbol, out);
+        ASSERT_UINT_EQUALS(value->code.num_bits, bits_read);
+
+        /* Trailing bits must not change the result */
+        bit_pattern |= UINT32_MAX >> value->code.num_bits;
+        bits_read = coder->decode(bit_pattern, &out, coder->userdata);
 
         ASSERT_UINT_EQUALS(value->symbol, out);
         ASSERT_UINT_EQUALS(value->code.num_bits, bits_read);
     }
 
+    /* The table has no 5 bit codes starting with 0000 */
+    uint8_t out = 0;
+    ASSERT_UINT_EQUALS(0, coder->decode(0, &out, coder->userdata));
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(huffman_encoder_exact_output, test_huffman_encoder_exact_output)
+static int test_huffman_encoder_exact_output(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+    /* Test encoding a string that ends on a byte boundary into a buffer of exactly the right size */
+
+    static const uint8_t s_encoded_even_bytes[] = {0x82, 0x18, 0xa3};
+    uint8_t output_buffer[sizeof(s_encoded_even_bytes)];
+    struct aws_byte_buf output_buf = aws_byte_buf_from_empty_array(output_buffer, sizeof(output_buffer));
+
+    struct aws_huffman_encoder encoder;
+    aws_huffman_encoder_init(&encoder, test_get_coder());
+
+    struct aws_byte_cursor to_encode = aws_byte_cursor_from_c_str("cdfh");
+    ASSERT_SUCCESS(aws_huffman_encode(&encoder, &to_encode, &output_buf));
+
+    ASSERT_UINT_EQUALS(0, to_encode.len);
+    ASSERT_UINT_EQUALS(0, encoder.overflow_bits.num_bits);
+    ASSERT_BIN_ARRAYS_EQUALS(s_encoded_even_bytes, sizeof(s_encoded_even_bytes), output_buf.buffer, output_buf.len);
+
+    return AWS_OP_SUCCESS;
+}
+
+/* Packs code the way packed_codes entries hold it */
+static uint32_t s_pack_code(struct aws_huffman_code code) {
+    return (1u << code.num_bits) | code.pattern;
+}
+
+AWS_TEST_CASE(huffman_packed_codes, test_huffman_packed_codes)
+static int test_huffman_packed_codes(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+    /* Test that packed codes match encode, and that entries of 0 fall back to it */
+
+    struct aws_huffman_symbol_coder *coders[] = {
+        test_get_coder(),
+        test_table_get_coder(),
+        test_multi_get_coder(),
+        test_canonical_get_coder(),
+        test_small_table_get_coder(),
+    };
+
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(coders); ++i) {
+        ASSERT_NOT_NULL(coders[i]->packed_codes);
+        for (size_t symbol = 0; symbol < 256; ++symbol) {
+            struct aws_huffman_code code = coders[i]->encode((uint8_t)symbol, coders[i]->userdata);
+            ASSERT_UINT_EQUALS(code.num_bits ? s_pack_code(code) : 0, coders[i]->packed_codes[symbol]);
+        }
+    }
+
+    /* Without packed codes, or with only some of them, the output doesn't change */
+    uint32_t partial_codes[256];
+    for (size_t symbol = 0; symbol < 256; ++symbol) {
+        partial_codes[symbol] = symbol % 2 ? test_get_coder()->packed_codes[symbol] : 0;
+    }
+    const uint32_t *packed_codes[] = {NULL, partial_codes};
+
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(packed_codes); ++i) {
+        struct aws_huffman_symbol_coder coder = *test_get_coder();
+        coder.packed_codes = packed_codes[i];
+
+        struct aws_huffman_encoder encoder;
+        aws_huffman_encoder_init(&encoder, &coder);
+
+        uint8_t output_buffer[ENCODED_CODES_LEN];
+        struct aws_byte_buf output_buf = aws_byte_buf_from_empty_array(output_buffer, sizeof(output_buffer));
+        struct aws_byte_cursor to_encode = aws_byte_cursor_from_array(s_all_codes, ALL_CODES_LEN);
+        ASSERT_SUCCESS(aws_huffman_encode(&encoder, &to_encode, &output_buf));
+        ASSERT_BIN_ARRAYS_EQUALS(s_encoded_codes, ENCODED_CODES_LEN, output_buf.buffer, output_buf.len);
+    }
+
+    /* Codes up to 31 bits, like HPACK's 30 bit codes, are packed; only 32 bit codes are left to encode */
+    uint8_t code_lengths[256];
+    AWS_ZERO_ARRAY(code_lengths);
+    for (size_t symbol = 0; symbol < 31; ++symbol) {
+        code_lengths[symbol] = (uint8_t)(symbol + 1);
+    }
+    code_lengths[31] = 32;
+    code_lengths[32] = 32;
+
+    struct aws_huffman_symbol_coder *coder = aws_huffman_coder_new_from_lengths(allocator, code_lengths);
+    ASSERT_NOT_NULL(coder);
+    for (size_t symbol = 0; symbol <= 32; ++symbol) {
+        struct aws_huffman_code code = coder->encode((uint8_t)symbol, coder->userdata);
+        ASSERT_UINT_EQUALS(code_lengths[symbol], code.num_bits);
+        const uint32_t expected = code.num_bits <= AWS_HUFFMAN_PACKED_MAX_CODE_LENGTH ? s_pack_code(code) : 0;
+        ASSERT_UINT_EQUALS(expected, coder->packed_codes[symbol]);
+    }
+    ASSERT_UINT_EQUALS(0, coder->packed_codes[31]);
+
+    static const uint8_t s_long_codes[] = {0, 29, 31, 30, 32, 26, 27, 1};
+    uint8_t encoded_buffer[32];
+    struct aws_byte_buf encoded_buf = aws_byte_buf_from_empty_array(encoded_buffer, sizeof(encoded_buffer));
+    struct aws_byte_cursor to_encode = aws_byte_cursor_from_array(s_long_codes, sizeof(s_long_codes));
+
+    struct aws_huffman_encoder encoder;
+    aws_huffman_encoder_init(&encoder, coder);
+    const size_t encoded_length = aws_huffman_get_encoded_length(&encoder, to_encode);
+    ASSERT_SUCCESS(aws_huffman_encode(&encoder, &to_encode, &encoded_buf));
+    ASSERT_UINT_EQUALS(encoded_length, encoded_buf.len);
+
+    uint8_t decoded_buffer[sizeof(s_long_codes)];
+    struct aws_byte_buf decoded_buf = aws_byte_buf_from_empty_array(decoded_buffer, sizeof(decoded_buffer));
+    struct aws_byte_cursor to_decode = aws_byte_cursor_from_buf(&encoded_buf);
+
+    struct aws_huffman_decoder decoder;
+    aws_huffman_decoder_init(&decoder, coder);
+    ASSERT_SUCCESS(aws_huffman_decode(&decoder, &to_decode, &decoded_buf));
+    ASSERT_BIN_ARRAYS_EQUALS(s_long_codes, sizeof(s_long_codes), decoded_buf.buffer, decoded_buf.len);
+
+    aws_huffman_coder_destroy(coder);
+
     return AWS_OP_SUCCESS;
 }
 
+AWS_TEST_CASE(huffman_symbol_decoder, test_huffman_symbol_decoder)
+static int test_huffman_symbol_decoder(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+    /* Test decoding each character */
+
+    return s_test_symbol_decoder(test_get_coder());
+}
+
 AWS_TEST_CASE(huffman_decoder, test_huffman_decoder)
 static int test_huffman_decoder(struct aws_allocator *allocator, void *ctx) {
     (void)allocator;
@@ -250,14 +828,10 @@ static int test_huffman_decoder_all_code_points(struct aws_allocator *allocator,
     return AWS_OP_SUCCESS;
 }
 
-AWS_TEST_CASE(huffman_decoder_partial_input, test_huffman_decoder_partial_input)
-static int test_huffman_decoder_partial_input(struct aws_allocator *allocator, void *ctx) {
-    (void)allocator;
-    (void)ctx;
-    /* Test decoding a buffer in chunks */
+static int s_test_decoder_partial_input(struct aws_huffman_symbol_coder *coder) {
 
     struct aws_huffman_decoder decoder;
-    aws_huffman_decoder_init(&decoder, test_get_coder());
+    aws_huffman_decoder_init(&decoder, coder);
 
     char output_buffer[150];
 
@@ -291,60 +865,326 @@ static int test_huffman_decoder_partial_input(struct aws_allocator *allocator, v
     return AWS_OP_SUCCESS;
 }
 
-AWS_TEST_CASE(huffman_decoder_partial_output, test_huffman_decoder_partial_output)
-static int test_huffman_decoder_partial_output(struct aws_allocator *allocator, void *ctx) {
+AWS_TEST_CASE(huffman_decoder_padding_bits, test_huffman_decoder_padding_bits)
+static int test_huffman_decoder_padding_bits(struct aws_allocator *allocator, void *ctx) {
     (void)allocator;
     (void)ctx;
-    /* Test decoding when the output buffer size is limited */
-
-    struct aws_huffman_decoder decoder;
-    aws_huffman_decoder_init(&decoder, test_get_coder());
+    /* Test that only the padding is left in working_bits after decoding, however the input was read */
 
-    char output_buffer[150];
-
-    for (size_t i = 0; i < NUM_STEP_SIZES; ++i) {
-        const size_t step_size = s_step_sizes[i];
+    struct aws_huffman_symbol_coder *coders[] = {test_get_coder(), test_table_get_coder(), test_multi_get_coder()};
 
-        aws_huffman_decoder_reset(&decoder);
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(coders); ++i) {
+        struct aws_huffman_decoder decoder;
+        aws_huffman_decoder_init(&decoder, coders[i]);
 
+        char output_buffer[ALL_CODES_LEN];
         struct aws_byte_cursor to_decode = aws_byte_cursor_from_array(s_encoded_codes, ENCODED_CODES_LEN);
-        struct aws_byte_buf output_buf = aws_byte_buf_from_empty_array(output_buffer, (size_t)-1);
-        output_buf.capacity = 0; /* Can't set above because it sets buffer to 0 */
-        AWS_ZERO_ARRAY(output_buffer);
-
-        do {
-            output_buf.capacity += step_size;
-            if (output_buf.capacity > ALL_CODES_LEN) {
-                output_buf.capacity = ALL_CODES_LEN;
-            }
-
-            const size_t previous_output_size = output_buf.len;
-
-            int result = aws_huffman_decode(&decoder, &to_decode, &output_buf);
-
-            ASSERT_TRUE(output_buf.len > previous_output_size);
-            ASSERT_BIN_ARRAYS_EQUALS(s_all_codes, output_buf.len, output_buf.buffer, output_buf.len);
-
-            if (output_buf.len == ALL_CODES_LEN) {
-                ASSERT_SUCCESS(result);
-            } else {
-                ASSERT_UINT_EQUALS(AWS_ERROR_SHORT_BUFFER, aws_last_error());
-                aws_reset_error();
-            }
-        } while (output_buf.len < ALL_CODES_LEN);
+        struct aws_byte_buf output_buf = aws_byte_buf_from_empty_array(output_buffer, sizeof(output_buffer));
 
+        ASSERT_SUCCESS(aws_huffman_decode(&decoder, &to_decode, &output_buf));
         ASSERT_UINT_EQUALS(ALL_CODES_LEN, output_buf.len);
-        ASSERT_BIN_ARRAYS_EQUALS(s_all_codes, ALL_CODES_LEN, output_buf.buffer, output_buf.len);
+        ASSERT_TRUE(decoder.num_bits > 0 && decoder.num_bits < 8);
+        ASSERT_UINT_EQUALS(UINT64_MAX << (64 - decoder.num_bits), decoder.working_bits);
     }
 
     return AWS_OP_SUCCESS;
 }
 
-AWS_TEST_CASE(huffman_transitive, test_huffman_transitive)
-static int test_huffman_transitive(struct aws_allocator *allocator, void *ctx) {
+AWS_TEST_CASE(huffman_decoder_partial_input, test_huffman_decoder_partial_input)
+static int test_huffman_decoder_partial_input(struct aws_allocator *allocator, void *ctx) {
     (void)allocator;
     (void)ctx;
-    /* Test encoding a short url and immediately decoding it */
+    /* Test decoding a buffer in chunks */
+
+    return s_test_decoder_partial_input(test_get_coder());
+}
+
+AWS_TEST_CASE(huffman_decoder_unknown_symbol, test_huffman_decoder_unknown_symbol)
+static int test_huffman_decoder_unknown_symbol(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+    /* Test decoding bits that don't match any code, after some that do */
+
+    struct aws_huffman_symbol_coder *coders[] = {test_get_coder(), test_table_get_coder(), test_multi_get_coder()};
+
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(coders); ++i) {
+        struct aws_huffman_decoder decoder;
+        aws_huffman_decoder_init(&decoder, coders[i]);
+
+        /* ' ' (00100) followed by zeros. No code starts with 0000 */
+        uint8_t to_decode_buffer[] = {0x20, 0x00, 0x00, 0x00, 0x00, 0x00};
+        char output_buffer[sizeof(to_decode_buffer)];
+        struct aws_byte_cursor to_decode = aws_byte_cursor_from_array(to_decode_buffer, sizeof(to_decode_buffer));
+        struct aws_byte_buf output_buf = aws_byte_buf_from_empty_array(output_buffer, sizeof(output_buffer));
+
+        ASSERT_ERROR(AWS_ERROR_COMPRESSION_UNKNOWN_SYMBOL, aws_huffman_decode(&decoder, &to_decode, &output_buf));
+        ASSERT_UINT_EQUALS(1, output_buf.len);
+        ASSERT_UINT_EQUALS(' ', output_buffer[0]);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(huffman_decoded_length, test_huffman_decoded_length)
+static int test_huffman_decoded_length(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+    /* Test counting decoded symbols, from the start of a buffer and mid stream */
+
+    struct aws_huffman_symbol_coder *coders[] = {test_get_coder(), test_table_get_coder(), test_multi_get_coder()};
+
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(coders); ++i) {
+        struct aws_huffman_decoder decoder;
+        aws_huffman_decoder_init(&decoder, coders[i]);
+
+        struct aws_byte_cursor to_decode = aws_byte_cursor_from_array(s_encoded_codes, ENCODED_CODES_LEN);
+        size_t decoded_length = 0;
+        ASSERT_SUCCESS(aws_huffman_get_decoded_length(&decoder, to_decode, &decoded_length));
+        ASSERT_UINT_EQUALS(ALL_CODES_LEN, decoded_length);
+        ASSERT_UINT_EQUALS(0, decoder.num_bits);
+
+        /* Split the input, so the second half starts with bits left in the decoder */
+        char output_buffer[ALL_CODES_LEN];
+        struct aws_byte_buf output_buf = aws_byte_buf_from_empty_array(output_buffer, sizeof(output_buffer));
+        struct aws_byte_cursor first_half = aws_byte_cursor_advance(&to_decode, ENCODED_CODES_LEN / 2);
+
+        ASSERT_SUCCESS(aws_huffman_get_decoded_length(&decoder, first_half, &decoded_length));
+        ASSERT_SUCCESS(aws_huffman_decode(&decoder, &first_half, &output_buf));
+        ASSERT_UINT_EQUALS(output_buf.len, decoded_length);
+
+        ASSERT_SUCCESS(aws_huffman_get_decoded_length(&decoder, to_decode, &decoded_length));
+        ASSERT_UINT_EQUALS(ALL_CODES_LEN - output_buf.len, decoded_length);
+
+        uint8_t unknown_buffer[] = {0x20, 0x00, 0x00, 0x00, 0x00, 0x00};
+        aws_huffman_decoder_reset(&decoder);
+        ASSERT_ERROR(
+            AWS_ERROR_COMPRESSION_UNKNOWN_SYMBOL,
+            aws_huffman_get_decoded_length(
+                &decoder, aws_byte_cursor_from_array(unknown_buffer, sizeof(unknown_buffer)), &decoded_length));
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(huffman_decoder_partial_output, test_huffman_decoder_partial_output)
+static int test_huffman_decoder_partial_output(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+    /* Test decoding when the output buffer size is limited */
+
+    struct aws_huffman_decoder decoder;
+    aws_huffman_decoder_init(&decoder, test_get_coder());
+
+    char output_buffer[150];
+
+    for (size_t i = 0; i < NUM_STEP_SIZES; ++i) {
+        const size_t step_size = s_step_sizes[i];
+
+        aws_huffman_decoder_reset(&decoder);
+
+        struct aws_byte_cursor to_decode = aws_byte_cursor_from_array(s_encoded_codes, ENCODED_CODES_LEN);
+        struct aws_byte_buf output_buf = aws_byte_buf_from_empty_array(output_buffer, (size_t)-1);
+        output_buf.capacity = 0; /* Can't set above because it sets buffer to 0 */
+        AWS_ZERO_ARRAY(output_buffer);
+
+        do {
+            output_buf.capacity += step_size;
+            if (output_buf.capacity > ALL_CODES_LEN) {
+                output_buf.capacity = ALL_CODES_LEN;
+            }
+
+            const size_t previous_output_size = output_buf.len;
+
+            int result = aws_huffman_decode(&decoder, &to_decode, &output_buf);
+
+            ASSERT_TRUE(output_buf.len > previous_output_size);
+            ASSERT_BIN_ARRAYS_EQUALS(s_all_codes, output_buf.len, output_buf.buffer, output_buf.len);
+
+            if (output_buf.len == ALL_CODES_LEN) {
+                ASSERT_SUCCESS(result);
+            } else {
+                ASSERT_UINT_EQUALS(AWS_ERROR_SHORT_BUFFER, aws_last_error());
+                aws_reset_error();
+            }
+        } while (output_buf.len < ALL_CODES_LEN);
+
+        ASSERT_UINT_EQUALS(ALL_CODES_LEN, output_buf.len);
+        ASSERT_BIN_ARRAYS_EQUALS(s_all_codes, ALL_CODES_LEN, output_buf.buffer, output_buf.len);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(huffman_decoder_cursors, test_huffman_decoder_cursors)
+static int test_huffman_decoder_cursors(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+    /* Test decoding a buffer split into fragments, with limited output */
+
+    struct aws_huffman_symbol_coder *coders[] = {test_get_coder(), test_table_get_coder(), test_multi_get_coder()};
+
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(coders); ++i) {
+        for (size_t j = 0; j < NUM_STEP_SIZES; ++j) {
+            const size_t step_size = s_step_sizes[j];
+
+            struct aws_huffman_decoder decoder;
+            aws_huffman_decoder_init(&decoder, coders[i]);
+
+            /* Fragments of step_size bytes, with an empty one between each */
+            struct aws_byte_cursor fragments[ENCODED_CODES_LEN * 2];
+            size_t num_fragments = 0;
+            struct aws_byte_cursor to_decode = aws_byte_cursor_from_array(s_encoded_codes, ENCODED_CODES_LEN);
+            while (to_decode.len) {
+                const size_t fragment_len = to_decode.len < step_size ? to_decode.len : step_size;
+                fragments[num_fragments++] = aws_byte_cursor_advance(&to_decode, fragment_len);
+                fragments[num_fragments++] = aws_byte_cursor_from_array(NULL, 0);
+            }
+
+            char output_buffer[ALL_CODES_LEN];
+            struct aws_byte_buf output_buf = aws_byte_buf_from_empty_array(output_buffer, sizeof(output_buffer));
+            output_buf.capacity = 0;
+
+            do {
+                output_buf.capacity += step_size;
+                if (output_buf.capacity > ALL_CODES_LEN) {
+                    output_buf.capacity = ALL_CODES_LEN;
+                }
+
+                int result = aws_huffman_decode_cursors(&decoder, fragments, num_fragments, &output_buf);
+                ASSERT_BIN_ARRAYS_EQUALS(s_all_codes, output_buf.len, output_buf.buffer, output_buf.len);
+
+                if (output_buf.len == ALL_CODES_LEN) {
+                    ASSERT_SUCCESS(result);
+                } else {
+                    ASSERT_UINT_EQUALS(AWS_ERROR_SHORT_BUFFER, aws_last_error());
+                    aws_reset_error();
+                }
+            } while (output_buf.len < ALL_CODES_LEN);
+
+            for (size_t k = 0; k < num_fragments; ++k) {
+                ASSERT_UINT_EQUALS(0, fragments[k].len);
+            }
+        }
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(huffman_decoder_cursors_resume, test_huffman_decoder_cursors_resume)
+static int test_huffman_decoder_cursors_resume(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+    /* Test that resuming after a short buffer decodes the bits left in the decoder, even once every fragment is
+     * empty */
+
+    struct aws_huffman_symbol_coder *coders[] = {test_get_coder(), test_table_get_coder(), test_multi_get_coder()};
+
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(coders); ++i) {
+        for (size_t j = 0; j < NUM_STEP_SIZES; ++j) {
+            const size_t step_size = s_step_sizes[j];
+
+            struct aws_huffman_decoder decoder;
+            aws_huffman_decoder_init(&decoder, coders[i]);
+
+            struct aws_byte_cursor fragments[ENCODED_CODES_LEN];
+            size_t num_fragments = 0;
+            struct aws_byte_cursor to_decode = aws_byte_cursor_from_array(s_encoded_codes, ENCODED_CODES_LEN);
+            while (to_decode.len) {
+                const size_t fragment_len = to_decode.len < step_size ? to_decode.len : step_size;
+                fragments[num_fragments++] = aws_byte_cursor_advance(&to_decode, fragment_len);
+            }
+
+            /* The output grows one byte per call, so the input runs out well before the output does */
+            char output_buffer[ALL_CODES_LEN];
+            struct aws_byte_buf output_buf = aws_byte_buf_from_empty_array(output_buffer, sizeof(output_buffer));
+            output_buf.capacity = 1;
+
+            while (aws_huffman_decode_cursors(&decoder, fragments, num_fragments, &output_buf)) {
+                ASSERT_INT_EQUALS(AWS_ERROR_SHORT_BUFFER, aws_last_error());
+                ASSERT_TRUE(output_buf.capacity < ALL_CODES_LEN);
+                ++output_buf.capacity;
+            }
+
+            ASSERT_BIN_ARRAYS_EQUALS(s_all_codes, ALL_CODES_LEN, output_buf.buffer, output_buf.len);
+        }
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(huffman_transitive_dynamic, test_huffman_transitive_dynamic)
+static int test_huffman_transitive_dynamic(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+    /* Test encoding and decoding into buffers that start empty and are grown to fit */
+
+    struct aws_huffman_encoder encoder;
+    aws_huffman_encoder_init(&encoder, test_get_coder());
+
+    struct aws_byte_buf encoded_buf;
+    ASSERT_SUCCESS(aws_byte_buf_init(&encoded_buf, allocator, 3));
+
+    /* Running out of room leaves bits in the encoder, which must be counted when growing */
+    struct aws_byte_cursor to_encode = aws_byte_cursor_from_array(s_all_codes, ALL_CODES_LEN);
+    ASSERT_ERROR(AWS_ERROR_SHORT_BUFFER, aws_huffman_encode(&encoder, &to_encode, &encoded_buf));
+    ASSERT_TRUE(encoder.overflow_bits.num_bits > 0);
+    ASSERT_SUCCESS(aws_huffman_encode_dynamic(&encoder, &to_encode, &encoded_buf));
+    ASSERT_UINT_EQUALS(0, to_encode.len);
+    ASSERT_UINT_EQUALS(ENCODED_CODES_LEN, encoded_buf.capacity);
+    ASSERT_BIN_ARRAYS_EQUALS(s_encoded_codes, ENCODED_CODES_LEN, encoded_buf.buffer, encoded_buf.len);
+
+    /* A coder without metadata is bounded by one symbol per bit */
+    struct aws_huffman_symbol_coder coder_without_metadata = *test_multi_get_coder();
+    coder_without_metadata.min_code_length = 0;
+
+    struct aws_huffman_symbol_coder *coders[] = {
+        test_get_coder(), test_table_get_coder(), test_multi_get_coder(), &coder_without_metadata};
+
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(coders); ++i) {
+        struct aws_huffman_decoder decoder;
+        aws_huffman_decoder_init(&decoder, coders[i]);
+
+        struct aws_byte_buf decoded_buf;
+        ASSERT_SUCCESS(aws_byte_buf_init(&decoded_buf, allocator, 0));
+
+        struct aws_byte_cursor to_decode = aws_byte_cursor_from_buf(&encoded_buf);
+        while (to_decode.len) {
+            struct aws_byte_cursor chunk = aws_byte_cursor_advance(&to_decode, to_decode.len < 7 ? to_decode.len : 7);
+            ASSERT_SUCCESS(aws_huffman_decode_dynamic(&decoder, &chunk, &decoded_buf));
+            ASSERT_UINT_EQUALS(0, chunk.len);
+        }
+
+        ASSERT_BIN_ARRAYS_EQUALS(s_all_codes, ALL_CODES_LEN, decoded_buf.buffer, decoded_buf.len);
+
+        aws_byte_buf_clean_up(&decoded_buf);
+    }
+
+    aws_byte_buf_clean_up(&encoded_buf);
+
+    /* Input made only of symbols without a code is rejected, not taken as empty */
+    uint8_t code_lengths[256];
+    AWS_ZERO_ARRAY(code_lengths);
+    code_lengths['a'] = 1;
+    code_lengths['b'] = 2;
+
+    struct aws_huffman_symbol_coder *coder = aws_huffman_coder_new_from_lengths(allocator, code_lengths);
+    ASSERT_NOT_NULL(coder);
+    aws_huffman_encoder_init(&encoder, coder);
+
+    ASSERT_SUCCESS(aws_byte_buf_init(&encoded_buf, allocator, 0));
+    to_encode = aws_byte_cursor_from_c_str("xyz");
+    ASSERT_ERROR(AWS_ERROR_COMPRESSION_UNKNOWN_SYMBOL, aws_huffman_encode_dynamic(&encoder, &to_encode, &encoded_buf));
+
+    aws_byte_buf_clean_up(&encoded_buf);
+    aws_huffman_coder_destroy(coder);
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(huffman_transitive, test_huffman_transitive)
+static int test_huffman_transitive(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+    /* Test encoding a short url and immediately decoding it */
 
     const char *error_message = NULL;
     int result =
@@ -382,6 +1222,25 @@ static int test_huffman_transitive_all_code_points(struct aws_allocator *allocat
     return AWS_OP_SUCCESS;
 }
 
+/* Encodes and decodes s_all_codes with coder through both chunked APIs, growing the output by each step size */
+static int s_test_transitive_chunked(struct aws_huffman_symbol_coder *coder) {
+
+    for (size_t i = 0; i < NUM_STEP_SIZES; ++i) {
+        const size_t step_size = s_step_sizes[i];
+
+        const char *error_message = NULL;
+        int result = huffman_test_transitive_chunked(
+            coder, s_all_codes, ALL_CODES_LEN, ENCODED_CODES_LEN, step_size, &error_message);
+        ASSERT_SUCCESS(result, error_message);
+
+        result = huffman_test_transitive_chunked_step(
+            coder, s_all_codes, ALL_CODES_LEN, ENCODED_CODES_LEN, step_size, &error_message);
+        ASSERT_SUCCESS(result, error_message);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
 AWS_TEST_CASE(huffman_transitive_chunked, test_huffman_transitive_chunked)
 static int test_huffman_transitive_chunked(struct aws_allocator *allocator, void *ctx) {
     (void)allocator;
@@ -389,14 +1248,789 @@ static int test_huffman_transitive_chunked(struct aws_allocator *allocator, void
     /* Test encoding a sequence of all character values expressable as
      * characters and immediately decoding it */
 
+    return s_test_transitive_chunked(test_get_coder());
+}
+
+AWS_TEST_CASE(huffman_table_symbol_decoder, test_huffman_table_symbol_decoder)
+static int test_huffman_table_symbol_decoder(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+    /* Test decoding each character with the lookup table decoder */
+
+    return s_test_symbol_decoder(test_table_get_coder());
+}
+
+AWS_TEST_CASE(huffman_table_decoder_partial_input, test_huffman_table_decoder_partial_input)
+static int test_huffman_table_decoder_partial_input(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+    /* Test decoding a buffer in chunks with the specialized table decode loops */
+
+    ASSERT_SUCCESS(s_test_decoder_partial_input(test_table_get_coder()));
+    ASSERT_SUCCESS(s_test_decoder_partial_input(test_multi_get_coder()));
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(huffman_table_transitive_chunked, test_huffman_table_transitive_chunked)
+static int test_huffman_table_transitive_chunked(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+    /* Test encoding a sequence of all character values expressable as
+     * characters and decoding it in chunks with the lookup table decoder */
+
+    return s_test_transitive_chunked(test_table_get_coder());
+}
+
+AWS_TEST_CASE(huffman_multi_symbol_decoder, test_huffman_multi_symbol_decoder)
+static int test_huffman_multi_symbol_decoder(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+    /* Test decoding each character, and every pair of characters that fits in one lookup */
+
+    struct aws_huffman_symbol_coder *coder = test_multi_get_coder();
+    ASSERT_SUCCESS(s_test_symbol_decoder(coder));
+
+    for (size_t i = 0; i < NUM_CODE_POINTS; ++i) {
+        struct huffman_test_code_point *first = &s_code_points[i];
+
+        for (size_t j = 0; j < NUM_CODE_POINTS; ++j) {
+            struct huffman_test_code_point *second = &s_code_points[j];
+
+            const uint8_t num_bits = first->code.num_bits + second->code.num_bits;
+            if (num_bits > 12) {
+                continue;
+            }
+
+            uint32_t bit_pattern = (first->code.pattern << (32 - first->code.num_bits)) |
+                                   (second->code.pattern << (32 - num_bits));
+
+            uint8_t symbols[AWS_HUFFMAN_MAX_DECODE_SYMBOLS];
+            uint8_t num_symbols = 0;
+            uint8_t bits_read = coder->decode_multi(bit_pattern, symbols, &num_symbols, NULL);
+
+            ASSERT_UINT_EQUALS(2, num_symbols);
+            ASSERT_UINT_EQUALS(num_bits, bits_read);
+            ASSERT_UINT_EQUALS(first->symbol, symbols[0]);
+            ASSERT_UINT_EQUALS(second->symbol, symbols[1]);
+        }
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(huffman_multi_transitive_chunked, test_huffman_multi_transitive_chunked)
+static int test_huffman_multi_transitive_chunked(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+    /* Test encoding a sequence of all character values expressable as
+     * characters and decoding it in chunks with the multi symbol decoder */
+
+    return s_test_transitive_chunked(test_multi_get_coder());
+}
+
+AWS_TEST_CASE(huffman_small_table_symbol_decoder, test_huffman_small_table_symbol_decoder)
+static int test_huffman_small_table_symbol_decoder(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+    /* Test decoding each character with 6 bit tables, which need sub tables for most codes */
+
+    struct aws_huffman_symbol_coder *coder = test_small_table_get_coder();
+    ASSERT_SUCCESS(s_test_symbol_decoder(coder));
+    ASSERT_SUCCESS(s_test_decoder_partial_input(coder));
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(huffman_small_table_transitive_chunked, test_huffman_small_table_transitive_chunked)
+static int test_huffman_small_table_transitive_chunked(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+    /* Test encoding a sequence of all character values expressable as
+     * characters and decoding it in chunks with 6 bit tables of at most 2 symbols */
+
+    return s_test_transitive_chunked(test_small_table_get_coder());
+}
+
+AWS_TEST_CASE(huffman_canonical_symbol_decoder, test_huffman_canonical_symbol_decoder)
+static int test_huffman_canonical_symbol_decoder(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+    /* Test decoding each character with the limit comparing decoder, and the gaps around its codes */
+
+    struct aws_huffman_symbol_coder *coder = test_canonical_get_coder();
+    ASSERT_SUCCESS(s_test_symbol_decoder(coder));
+    ASSERT_SUCCESS(s_test_decoder_partial_input(coder));
+
+    /* No code starts with 0000 or 0111, and 1111111111 is past the last code */
+    uint8_t symbol = 0;
+    ASSERT_UINT_EQUALS(0, coder->decode(0x00000000, &symbol, NULL));
+    ASSERT_UINT_EQUALS(0, coder->decode(0x70000000, &symbol, NULL));
+    ASSERT_UINT_EQUALS(0, coder->decode(0xffc00000, &symbol, NULL));
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(huffman_canonical_transitive_chunked, test_huffman_canonical_transitive_chunked)
+static int test_huffman_canonical_transitive_chunked(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+    /* Test encoding a sequence of all character values expressable as
+     * characters and decoding it in chunks with the limit comparing decoder */
+
+    return s_test_transitive_chunked(test_canonical_get_coder());
+}
+
+struct static_coder {
+    struct aws_huffman_symbol_coder *(*get_coder)(void);
+    int (*encode)(struct aws_huffman_encoder *, struct aws_byte_cursor *, struct aws_byte_buf *);
+    int (*decode)(struct aws_huffman_decoder *, struct aws_byte_cursor *, struct aws_byte_buf *);
+};
+
+#define STATIC_CODER(name)                                                                                             \
+    { .get_coder = name##_get_coder, .encode = name##_encode, .decode = name##_decode }
+
+static const struct static_coder s_static_coders[] = {
+    STATIC_CODER(test),
+    STATIC_CODER(test_table),
+    STATIC_CODER(test_multi),
+    STATIC_CODER(test_canonical),
+    STATIC_CODER(test_small_table),
+};
+
+/* Encodes and decodes s_all_codes with coder's specialized functions, growing the output step_size bytes at a time */
+static int s_test_static_coder_chunked(const struct static_coder *coder, size_t step_size) {
+
+    struct aws_huffman_encoder encoder;
+    aws_huffman_encoder_init(&encoder, coder->get_coder());
+
+    uint8_t encoded_buffer[ENCODED_CODES_LEN];
+    struct aws_byte_buf encoded_buf = aws_byte_buf_from_empty_array(encoded_buffer, sizeof(encoded_buffer));
+    encoded_buf.capacity = 0;
+    struct aws_byte_cursor to_encode = aws_byte_cursor_from_array(s_all_codes, ALL_CODES_LEN);
+
+    while (coder->encode(&encoder, &to_encode, &encoded_buf)) {
+        ASSERT_INT_EQUALS(AWS_ERROR_SHORT_BUFFER, aws_last_error());
+        ASSERT_TRUE(encoded_buf.capacity < ENCODED_CODES_LEN);
+
+        encoded_buf.capacity += step_size;
+        if (encoded_buf.capacity > ENCODED_CODES_LEN) {
+            encoded_buf.capacity = ENCODED_CODES_LEN;
+        }
+    }
+    ASSERT_UINT_EQUALS(0, to_encode.len);
+    ASSERT_UINT_EQUALS(0, encoder.overflow_bits.num_bits);
+    ASSERT_BIN_ARRAYS_EQUALS(s_encoded_codes, ENCODED_CODES_LEN, encoded_buf.buffer, encoded_buf.len);
+
+    struct aws_huffman_decoder decoder;
+    aws_huffman_decoder_init(&decoder, coder->get_coder());
+
+    char decoded_buffer[ALL_CODES_LEN];
+    struct aws_byte_buf decoded_buf = aws_byte_buf_from_empty_array(decoded_buffer, sizeof(decoded_buffer));
+    decoded_buf.capacity = 0;
+    struct aws_byte_cursor to_decode = aws_byte_cursor_from_buf(&encoded_buf);
+
+    while (coder->decode(&decoder, &to_decode, &decoded_buf)) {
+        ASSERT_INT_EQUALS(AWS_ERROR_SHORT_BUFFER, aws_last_error());
+        ASSERT_TRUE(decoded_buf.capacity < ALL_CODES_LEN);
+
+        decoded_buf.capacity += step_size;
+        if (decoded_buf.capacity > ALL_CODES_LEN) {
+            decoded_buf.capacity = ALL_CODES_LEN;
+        }
+    }
+    ASSERT_UINT_EQUALS(0, to_decode.len);
+    ASSERT_BIN_ARRAYS_EQUALS(s_all_codes, ALL_CODES_LEN, decoded_buf.buffer, decoded_buf.len);
+
+    return AWS_OP_SUCCESS;
+}
+
+/* Encodes every prefix of s_all_codes whose codes fill whole 32 bit words into a buffer of exactly that size */
+static int s_test_static_coder_exact_fit(const struct static_coder *coder) {
+
+    struct aws_huffman_symbol_coder *symbol_coder = coder->get_coder();
+
+    size_t num_exact_fits = 0;
+    size_t num_bits = 0;
+    for (size_t len = 1; len <= ALL_CODES_LEN; ++len) {
+        num_bits += symbol_coder->encode(s_all_codes[len - 1], symbol_coder->userdata).num_bits;
+        if (num_bits % 32 != 0) {
+            continue;
+        }
+        ++num_exact_fits;
+
+        struct aws_huffman_encoder encoder;
+        aws_huffman_encoder_init(&encoder, symbol_coder);
+
+        uint8_t encoded_buffer[ENCODED_CODES_LEN];
+        struct aws_byte_buf encoded_buf = aws_byte_buf_from_empty_array(encoded_buffer, num_bits / 8);
+        struct aws_byte_cursor to_encode = aws_byte_cursor_from_array(s_all_codes, len);
+
+        ASSERT_SUCCESS(coder->encode(&encoder, &to_encode, &encoded_buf));
+        ASSERT_UINT_EQUALS(0, to_encode.len);
+        ASSERT_UINT_EQUALS(0, encoder.overflow_bits.num_bits);
+        ASSERT_UINT_EQUALS(num_bits / 8, encoded_buf.len);
+
+        /* Compare against the generic encoder, given room to spare */
+        struct aws_huffman_encoder generic_encoder;
+        aws_huffman_encoder_init(&generic_encoder, symbol_coder);
+
+        uint8_t generic_buffer[ENCODED_CODES_LEN];
+        struct aws_byte_buf generic_buf = aws_byte_buf_from_empty_array(generic_buffer, sizeof(generic_buffer));
+        struct aws_byte_cursor generic_to_encode = aws_byte_cursor_from_array(s_all_codes, len);
+        ASSERT_SUCCESS(aws_huffman_encode(&generic_encoder, &generic_to_encode, &generic_buf));
+        ASSERT_BIN_ARRAYS_EQUALS(generic_buf.buffer, generic_buf.len, encoded_buf.buffer, encoded_buf.len);
+    }
+    ASSERT_TRUE(num_exact_fits > 0);
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(huffman_static_coder, test_huffman_static_coder)
+static int test_huffman_static_coder(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+    /* Test the specialized encode and decode functions defined for each generated coder */
+
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(s_static_coders); ++i) {
+        const struct static_coder *coder = &s_static_coders[i];
+
+        for (size_t j = 0; j < NUM_STEP_SIZES; ++j) {
+            ASSERT_SUCCESS(s_test_static_coder_chunked(coder, s_step_sizes[j]));
+        }
+        ASSERT_SUCCESS(s_test_static_coder_exact_fit(coder));
+
+        /* Stats are still counted, through aws_huffman_encode and aws_huffman_decode */
+        struct aws_huffman_stats stats;
+        aws_huffman_stats_init(&stats);
+
+        struct aws_huffman_encoder encoder;
+        aws_huffman_encoder_init(&encoder, coder->get_coder());
+        encoder.stats = &stats;
+
+        uint8_t output_buffer[ENCODED_CODES_LEN];
+        struct aws_byte_buf output_buf = aws_byte_buf_from_empty_array(output_buffer, sizeof(output_buffer));
+        struct aws_byte_cursor to_encode = aws_byte_cursor_from_array(s_all_codes, ALL_CODES_LEN);
+        ASSERT_SUCCESS(coder->encode(&encoder, &to_encode, &output_buf));
+        ASSERT_BIN_ARRAYS_EQUALS(s_encoded_codes, ENCODED_CODES_LEN, output_buf.buffer, output_buf.len);
+
+        struct aws_huffman_decoder decoder;
+        aws_huffman_decoder_init(&decoder, coder->get_coder());
+        decoder.stats = &stats;
+
+        char decoded_buffer[ALL_CODES_LEN];
+        struct aws_byte_buf decoded_buf = aws_byte_buf_from_empty_array(decoded_buffer, sizeof(decoded_buffer));
+        struct aws_byte_cursor to_decode = aws_byte_cursor_from_buf(&output_buf);
+        ASSERT_SUCCESS(coder->decode(&decoder, &to_decode, &decoded_buf));
+        ASSERT_BIN_ARRAYS_EQUALS(s_all_codes, ALL_CODES_LEN, decoded_buf.buffer, decoded_buf.len);
+
+        struct aws_huffman_stats_snapshot snapshot;
+        aws_huffman_stats_snapshot(&stats, &snapshot);
+        ASSERT_UINT_EQUALS(2, snapshot.num_calls);
+        ASSERT_UINT_EQUALS(2 * ALL_CODES_LEN, snapshot.num_symbols);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(huffman_static_coder_long_codes, test_huffman_static_coder_long_codes)
+static int test_huffman_static_coder_long_codes(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+    /* Test that the specialized encode keeps going past 32 bit codes, which have no packed entry */
+
+    /* 'F' and 'G' have 32 bit codes, 'a' has a 1 bit code */
+    static const char s_long_codes[] = "aGbFEcGGdDaaaaaaaaFzGFGFGaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaF";
+    const size_t long_codes_len = sizeof(s_long_codes) - 1;
+    struct aws_huffman_symbol_coder *coder = test_long_codes_get_coder();
+    ASSERT_UINT_EQUALS(0, coder->packed_codes['F']);
+    ASSERT_UINT_EQUALS(0, coder->packed_codes['G']);
+
+    struct aws_huffman_encoder encoder;
+    aws_huffman_encoder_init(&encoder, coder);
+
+    uint8_t expected_buffer[128];
+    struct aws_byte_buf expected_buf = aws_byte_buf_from_empty_array(expected_buffer, sizeof(expected_buffer));
+    struct aws_byte_cursor to_encode = aws_byte_cursor_from_array(s_long_codes, long_codes_len);
+    ASSERT_SUCCESS(aws_huffman_encode(&encoder, &to_encode, &expected_buf));
+
     for (size_t i = 0; i < NUM_STEP_SIZES; ++i) {
-        const size_t step_size = s_step_sizes[i];
+        aws_huffman_encoder_reset(&encoder);
+
+        uint8_t encoded_buffer[sizeof(expected_buffer)];
+        struct aws_byte_buf encoded_buf = aws_byte_buf_from_empty_array(encoded_buffer, sizeof(encoded_buffer));
+        encoded_buf.capacity = 0;
+        to_encode = aws_byte_cursor_from_array(s_long_codes, long_codes_len);
+
+        while (test_long_codes_encode(&encoder, &to_encode, &encoded_buf)) {
+            ASSERT_INT_EQUALS(AWS_ERROR_SHORT_BUFFER, aws_last_error());
+            ASSERT_TRUE(encoded_buf.capacity < expected_buf.len);
+
+            encoded_buf.capacity += s_step_sizes[i];
+            if (encoded_buf.capacity > expected_buf.len) {
+                encoded_buf.capacity = expected_buf.len;
+            }
+        }
+        ASSERT_UINT_EQUALS(0, to_encode.len);
+        ASSERT_BIN_ARRAYS_EQUALS(expected_buf.buffer, expected_buf.len, encoded_buf.buffer, encoded_buf.len);
+
+        struct aws_huffman_decoder decoder;
+        aws_huffman_decoder_init(&decoder, coder);
+
+        char decoded_buffer[sizeof(s_long_codes)];
+        struct aws_byte_buf decoded_buf = aws_byte_buf_from_empty_array(decoded_buffer, sizeof(decoded_buffer));
+        struct aws_byte_cursor to_decode = aws_byte_cursor_from_buf(&encoded_buf);
+        ASSERT_SUCCESS(test_long_codes_decode(&decoder, &to_decode, &decoded_buf));
+        ASSERT_BIN_ARRAYS_EQUALS(s_long_codes, long_codes_len, decoded_buf.buffer, decoded_buf.len);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(huffman_coder_from_lengths, test_huffman_coder_from_lengths)
+static int test_huffman_coder_from_lengths(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+    /* Test building a canonical code with the static table's code lengths */
+
+    uint8_t code_lengths[256];
+    AWS_ZERO_ARRAY(code_lengths);
+    for (size_t i = 0; i < NUM_CODE_POINTS; ++i) {
+        code_lengths[s_code_points[i].symbol] = s_code_points[i].code.num_bits;
+    }
+
+    struct aws_huffman_symbol_coder *coder = aws_huffman_coder_new_from_lengths(allocator, code_lengths);
+    ASSERT_NOT_NULL(coder);
+    ASSERT_SUCCESS(s_test_coder_metadata(coder));
 
+    /* Codes are assigned in order of length, then symbol, starting from 0 */
+    struct aws_huffman_code next_code = {.pattern = 0, .num_bits = coder->min_code_length};
+    for (uint8_t len = coder->min_code_length; len <= coder->max_code_length; ++len) {
+        for (size_t symbol = 0; symbol < 256; ++symbol) {
+            if (code_lengths[symbol] != len) {
+                continue;
+            }
+
+            struct aws_huffman_code code = coder->encode((uint8_t)symbol, coder->userdata);
+            ASSERT_UINT_EQUALS(next_code.pattern << (len - next_code.num_bits), code.pattern);
+            ASSERT_UINT_EQUALS(len, code.num_bits);
+            next_code.pattern = code.pattern + 1;
+            next_code.num_bits = len;
+
+            uint8_t out = 0;
+            const uint32_t bits = code.pattern << (32 - len);
+            ASSERT_UINT_EQUALS(len, coder->decode(bits, &out, coder->userdata));
+            ASSERT_UINT_EQUALS(symbol, out);
+            ASSERT_UINT_EQUALS(len, coder->decode(bits | (UINT32_MAX >> len), &out, coder->userdata));
+            ASSERT_UINT_EQUALS(symbol, out);
+        }
+    }
+
+    ASSERT_SUCCESS(s_test_transitive_chunked(coder));
+
+    aws_huffman_coder_destroy(coder);
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(huffman_coder_from_invalid_lengths, test_huffman_coder_from_invalid_lengths)
+static int test_huffman_coder_from_invalid_lengths(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+    /* Test that lengths which don't describe a prefix code are rejected */
+
+    uint8_t code_lengths[256];
+
+    /* No codes */
+    AWS_ZERO_ARRAY(code_lengths);
+    ASSERT_NULL(aws_huffman_coder_new_from_lengths(allocator, code_lengths));
+    ASSERT_UINT_EQUALS(AWS_ERROR_COMPRESSION_INVALID_CODE_LENGTHS, aws_last_error());
+
+    /* Three 1 bit codes */
+    code_lengths['a'] = 1;
+    code_lengths['b'] = 1;
+    code_lengths['c'] = 1;
+    ASSERT_NULL(aws_huffman_coder_new_from_lengths(allocator, code_lengths));
+    ASSERT_UINT_EQUALS(AWS_ERROR_COMPRESSION_INVALID_CODE_LENGTHS, aws_last_error());
+
+    /* Longer than a code pattern */
+    code_lengths['c'] = 33;
+    ASSERT_NULL(aws_huffman_coder_new_from_lengths(allocator, code_lengths));
+    ASSERT_UINT_EQUALS(AWS_ERROR_COMPRESSION_INVALID_CODE_LENGTHS, aws_last_error());
+
+    /* Complete codes whose all 1s code is short enough to be end of stream padding */
+    code_lengths['c'] = 0;
+    ASSERT_NULL(aws_huffman_coder_new_from_lengths(allocator, code_lengths));
+    ASSERT_UINT_EQUALS(AWS_ERROR_COMPRESSION_INVALID_CODE_LENGTHS, aws_last_error());
+
+    code_lengths['b'] = 2;
+    code_lengths['c'] = 2;
+    ASSERT_NULL(aws_huffman_coder_new_from_lengths(allocator, code_lengths));
+    ASSERT_UINT_EQUALS(AWS_ERROR_COMPRESSION_INVALID_CODE_LENGTHS, aws_last_error());
+
+    for (size_t i = 0; i < 7; ++i) {
+        code_lengths['a' + i] = (uint8_t)(i + 1);
+    }
+    code_lengths['h'] = 7;
+    ASSERT_NULL(aws_huffman_coder_new_from_lengths(allocator, code_lengths));
+    ASSERT_UINT_EQUALS(AWS_ERROR_COMPRESSION_INVALID_CODE_LENGTHS, aws_last_error());
+
+    /* An incomplete code is fine, its unused prefixes just don't decode */
+    AWS_ZERO_ARRAY(code_lengths);
+    code_lengths['a'] = 1;
+    code_lengths['b'] = 2;
+    struct aws_huffman_symbol_coder *coder = aws_huffman_coder_new_from_lengths(allocator, code_lengths);
+    ASSERT_NOT_NULL(coder);
+
+    uint8_t symbol = 0;
+    ASSERT_UINT_EQUALS(1, coder->decode(0x00000000, &symbol, coder->userdata));
+    ASSERT_UINT_EQUALS('a', symbol);
+    ASSERT_UINT_EQUALS(2, coder->decode(0x80000000, &symbol, coder->userdata));
+    ASSERT_UINT_EQUALS('b', symbol);
+    ASSERT_UINT_EQUALS(0, coder->decode(0xc0000000, &symbol, coder->userdata));
+
+    aws_huffman_coder_destroy(coder);
+
+    return AWS_OP_SUCCESS;
+}
+
+/* Encodes and decodes every string of up to 3 of the symbols with a code, and a longer run of them */
+static int s_test_sparse_coder_round_trip(struct aws_huffman_symbol_coder *coder, const uint8_t *code_lengths) {
+
+    char symbols[256];
+    size_t num_symbols = 0;
+    for (size_t i = 0; i < 256; ++i) {
+        if (code_lengths[i]) {
+            symbols[num_symbols++] = (char)i;
+        }
+    }
+
+    const char *error_message = NULL;
+    for (size_t len = 1; len <= 3; ++len) {
+        size_t num_strings = 1;
+        for (size_t i = 0; i < len; ++i) {
+            num_strings *= num_symbols;
+        }
+
+        for (size_t n = 0; n < num_strings; ++n) {
+            char input[3];
+            size_t digits = n;
+            for (size_t i = 0; i < len; ++i) {
+                input[i] = symbols[digits % num_symbols];
+                digits /= num_symbols;
+            }
+
+            ASSERT_SUCCESS(huffman_test_transitive(coder, input, len, 0, &error_message), error_message);
+            ASSERT_SUCCESS(huffman_test_transitive_chunked(coder, input, len, 0, 1, &error_message), error_message);
+            ASSERT_SUCCESS(
+                huffman_test_transitive_chunked_step(coder, input, len, 0, 1, &error_message), error_message);
+        }
+    }
+
+    char run[100];
+    for (size_t i = 0; i < sizeof(run); ++i) {
+        run[i] = symbols[(i * 7 + i / 3) % num_symbols];
+    }
+    ASSERT_SUCCESS(huffman_test_transitive(coder, run, sizeof(run), 0, &error_message), error_message);
+    ASSERT_SUCCESS(huffman_test_transitive_chunked(coder, run, sizeof(run), 0, 3, &error_message), error_message);
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(huffman_coder_from_sparse_lengths, test_huffman_coder_from_sparse_lengths)
+static int test_huffman_coder_from_sparse_lengths(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+    /* Test that codes with only a few short codes don't decode the end of stream padding as symbols */
+
+    static const char *s_length_sets[] = {
+        /* One symbol */
+        "a1",
+        /* Three symbols */
+        "a1b2c3",
+        "a2b2c2",
+        /* Every code length up to 7, with only the 7 bit all 1s code unused */
+        "a1b2c3d4e5f6g7",
+        "h2e2l2o3w4",
+        /* Short codes padded out with long ones */
+        "a1b3c3d4e8f8",
+    };
+
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(s_length_sets); ++i) {
+        uint8_t code_lengths[256];
+        AWS_ZERO_ARRAY(code_lengths);
+        for (const char *entry = s_length_sets[i]; *entry; entry += 2) {
+            code_lengths[(uint8_t)entry[0]] = (uint8_t)(entry[1] - '0');
+        }
+
+        struct aws_huffman_symbol_coder *coder = aws_huffman_coder_new_from_lengths(allocator, code_lengths);
+        ASSERT_NOT_NULL(coder);
+        ASSERT_TRUE(coder->max_code_length > 7);
+
+        ASSERT_SUCCESS(s_test_sparse_coder_round_trip(coder, code_lengths));
+
+        /* The unused all 1s prefix is still rejected once there are more bits than padding */
+        struct aws_huffman_decoder decoder;
+        aws_huffman_decoder_init(&decoder, coder);
+        static const uint8_t s_all_ones[] = {0xff, 0xff};
+        struct aws_byte_cursor to_decode = aws_byte_cursor_from_array(s_all_ones, sizeof(s_all_ones));
+        char decoded_buffer[16];
+        struct aws_byte_buf decoded_buf = aws_byte_buf_from_empty_array(decoded_buffer, sizeof(decoded_buffer));
+        ASSERT_ERROR(AWS_ERROR_COMPRESSION_UNKNOWN_SYMBOL, aws_huffman_decode(&decoder, &to_decode, &decoded_buf));
+
+        aws_huffman_coder_destroy(coder);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+static uint64_t s_code_cost(const uint64_t *frequencies, const uint8_t *code_lengths) {
+
+    uint64_t cost = 0;
+    for (size_t i = 0; i < 256; ++i) {
+        cost += frequencies[i] * code_lengths[i];
+    }
+    return cost;
+}
+
+/* Builds a coder from code_lengths, and round trips every string of up to 3 of its symbols through it */
+static int s_test_lengths_round_trip(struct aws_allocator *allocator, const uint8_t *code_lengths) {
+
+    struct aws_huffman_symbol_coder *coder = aws_huffman_coder_new_from_lengths(allocator, code_lengths);
+    ASSERT_NOT_NULL(coder);
+    ASSERT_SUCCESS(s_test_sparse_coder_round_trip(coder, code_lengths));
+    aws_huffman_coder_destroy(coder);
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(huffman_code_lengths_from_frequencies, test_huffman_code_lengths_from_frequencies)
+static int test_huffman_code_lengths_from_frequencies(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+    /* Test building length limited codes from frequencies */
+
+    uint64_t frequencies[256];
+    uint8_t code_lengths[256];
+    struct aws_huffman_code codes[256];
+
+    /* Unlimited, these make a code of 1, 2, 3, 4 and 5 bits, and the unused end of stream code
+     * takes the other 5 bits. Limited to 3 bits, the best is 2, 2, 3, 3 and 3 bits */
+    AWS_ZERO_ARRAY(frequencies);
+    frequencies['a'] = 1;
+    frequencies['b'] = 1;
+    frequencies['c'] = 2;
+    frequencies['d'] = 4;
+    frequencies['e'] = 8;
+
+    ASSERT_SUCCESS(aws_huffman_code_lengths_from_frequencies(frequencies, 8, code_lengths));
+    ASSERT_UINT_EQUALS(5, code_lengths['a']);
+    ASSERT_UINT_EQUALS(4, code_lengths['b']);
+    ASSERT_UINT_EQUALS(3, code_lengths['c']);
+    ASSERT_UINT_EQUALS(2, code_lengths['d']);
+    ASSERT_UINT_EQUALS(1, code_lengths['e']);
+    ASSERT_UINT_EQUALS(0, code_lengths['f']);
+    ASSERT_SUCCESS(s_test_lengths_round_trip(allocator, code_lengths));
+
+    ASSERT_SUCCESS(aws_huffman_code_lengths_from_frequencies(frequencies, 3, code_lengths));
+    ASSERT_UINT_EQUALS(3, code_lengths['a']);
+    ASSERT_UINT_EQUALS(3, code_lengths['b']);
+    ASSERT_UINT_EQUALS(3, code_lengths['c']);
+    ASSERT_UINT_EQUALS(2, code_lengths['d']);
+    ASSERT_UINT_EQUALS(2, code_lengths['e']);
+    ASSERT_SUCCESS(s_test_lengths_round_trip(allocator, code_lengths));
+
+    /* A single symbol still needs a bit, and leaves the other 1 bit code unused */
+    AWS_ZERO_ARRAY(frequencies);
+    frequencies['a'] = 10;
+    ASSERT_SUCCESS(aws_huffman_code_lengths_from_frequencies(frequencies, 8, code_lengths));
+    ASSERT_UINT_EQUALS(1, code_lengths['a']);
+    ASSERT_SUCCESS(s_test_lengths_round_trip(allocator, code_lengths));
+
+    ASSERT_SUCCESS(aws_huffman_code_lengths_from_frequencies(frequencies, 1, code_lengths));
+    ASSERT_UINT_EQUALS(1, code_lengths['a']);
+
+    /* A small English text histogram, with short codes that fill most of the code space */
+    static const char s_text[] = "hello world, the quick brown fox jumps over the lazy dog while the old owl howls";
+    AWS_ZERO_ARRAY(frequencies);
+    for (size_t i = 0; i < sizeof(s_text) - 1; ++i) {
+        ++frequencies[(uint8_t)s_text[i]];
+    }
+    for (uint8_t max_code_length = 5; max_code_length <= 12; ++max_code_length) {
+        ASSERT_SUCCESS(aws_huffman_code_lengths_from_frequencies(frequencies, max_code_length, code_lengths));
+        ASSERT_SUCCESS(s_test_lengths_round_trip(allocator, code_lengths));
+
+        struct aws_huffman_symbol_coder *coder = aws_huffman_coder_new_from_lengths(allocator, code_lengths);
+        ASSERT_NOT_NULL(coder);
         const char *error_message = NULL;
-        int result = huffman_test_transitive_chunked(
-            test_get_coder(), s_all_codes, ALL_CODES_LEN, ENCODED_CODES_LEN, step_size, &error_message);
-        ASSERT_SUCCESS(result, error_message);
+        ASSERT_SUCCESS(
+            huffman_test_transitive(coder, s_text, sizeof(s_text) - 1, 0, &error_message), error_message);
+        ASSERT_SUCCESS(huffman_test_transitive(coder, "hello", 5, 0, &error_message), error_message);
+        aws_huffman_coder_destroy(coder);
     }
 
+    /* Every symbol, with skewed frequencies. Tighter limits can only cost more */
+    for (size_t i = 0; i < 256; ++i) {
+        frequencies[i] = 1 + (i % 7 == 0 ? (uint64_t)1 << (i % 40) : i);
+    }
+    for (size_t i = 0; i < ALL_CODES_LEN; ++i) {
+        frequencies[(uint8_t)s_all_codes[i]] += 1000;
+    }
+
+    uint64_t previous_cost = 0;
+    for (uint8_t max_code_length = 32; max_code_length >= 8; --max_code_length) {
+        ASSERT_SUCCESS(aws_huffman_code_lengths_from_frequencies(frequencies, max_code_length, code_lengths));
+
+        for (size_t i = 0; i < 256; ++i) {
+            ASSERT_TRUE(code_lengths[i] >= 1 && code_lengths[i] <= max_code_length);
+        }
+        ASSERT_SUCCESS(aws_huffman_assign_canonical_codes(code_lengths, codes));
+
+        const uint64_t cost = s_code_cost(frequencies, code_lengths);
+        ASSERT_TRUE(cost >= previous_cost);
+        previous_cost = cost;
+    }
+
+    /* The lengths build a working coder */
+    ASSERT_SUCCESS(aws_huffman_code_lengths_from_frequencies(frequencies, 11, code_lengths));
+    struct aws_huffman_symbol_coder *coder = aws_huffman_coder_new_from_lengths(allocator, code_lengths);
+    ASSERT_NOT_NULL(coder);
+    ASSERT_UINT_EQUALS(11, coder->max_code_length);
+
+    struct aws_huffman_encoder encoder;
+    aws_huffman_encoder_init(&encoder, coder);
+    const size_t encoded_length =
+        aws_huffman_get_encoded_length(&encoder, aws_byte_cursor_from_array(s_all_codes, ALL_CODES_LEN));
+
+    const char *error_message = NULL;
+    ASSERT_SUCCESS(
+        huffman_test_transitive_chunked(coder, s_all_codes, ALL_CODES_LEN, encoded_length, 4, &error_message),
+        error_message);
+
+    aws_huffman_coder_destroy(coder);
+
+    /* Nothing to code, or too many symbols for the limit. 8 symbols in 3 bits leave no room for the end of stream */
+    AWS_ZERO_ARRAY(frequencies);
+    ASSERT_ERROR(AWS_ERROR_INVALID_ARGUMENT, aws_huffman_code_lengths_from_frequencies(frequencies, 8, code_lengths));
+    for (size_t i = 0; i < 8; ++i) {
+        frequencies[i] = 1;
+    }
+    ASSERT_ERROR(AWS_ERROR_INVALID_ARGUMENT, aws_huffman_code_lengths_from_frequencies(frequencies, 3, code_lengths));
+    ASSERT_SUCCESS(aws_huffman_code_lengths_from_frequencies(frequencies, 4, code_lengths));
+    ASSERT_SUCCESS(s_test_lengths_round_trip(allocator, code_lengths));
+
+    /* All 256 symbols in 8 bits is the one code without room for the end of stream, and doesn't need it */
+    for (size_t i = 0; i < 256; ++i) {
+        frequencies[i] = 1 + i;
+    }
+    ASSERT_SUCCESS(aws_huffman_code_lengths_from_frequencies(frequencies, 8, code_lengths));
+    for (size_t i = 0; i < 256; ++i) {
+        ASSERT_UINT_EQUALS(8, code_lengths[i]);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+/* Encodes each value with the test coder, sampling every byte */
+static int s_sample_values(struct aws_huffman_sampler *sampler, const char **values, size_t num_values) {
+
+    struct aws_huffman_encoder encoder;
+    aws_huffman_encoder_init(&encoder, test_get_coder());
+    encoder.sampler = sampler;
+
+    for (size_t i = 0; i < num_values; ++i) {
+        uint8_t output_buffer[64];
+        struct aws_byte_buf output_buf = aws_byte_buf_from_empty_array(output_buffer, sizeof(output_buffer));
+        struct aws_byte_cursor to_encode = aws_byte_cursor_from_c_str(values[i]);
+        ASSERT_SUCCESS(aws_huffman_encode(&encoder, &to_encode, &output_buf));
+        aws_huffman_encoder_reset(&encoder);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(huffman_sampler_retrain, test_huffman_sampler_retrain)
+static int test_huffman_sampler_retrain(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+    /* Test that a coder retrained on sampled traffic with only a few symbols decodes what it encodes */
+
+    static const char *s_status_values[] = {"200", "204", "304", "404", "200", "200", "500", "301", "200"};
+    static const char *s_length_values[] = {"1024", "0", "65536", "12", "1024", "1024", "31337"};
+    static const char *s_single_values[] = {"a", "aaaa", "aaaaaaaaa"};
+
+    struct {
+        const char **values;
+        size_t num_values;
+    } s_traffic[] = {
+        {s_status_values, AWS_ARRAY_SIZE(s_status_values)},
+        {s_length_values, AWS_ARRAY_SIZE(s_length_values)},
+        {s_single_values, AWS_ARRAY_SIZE(s_single_values)},
+    };
+
+    for (size_t t = 0; t < AWS_ARRAY_SIZE(s_traffic); ++t) {
+        /* Two samplers, as if on two threads, merged into one histogram */
+        struct aws_huffman_sampler samplers[2];
+        struct aws_huffman_histogram histogram;
+        aws_huffman_histogram_init(&histogram);
+
+        const size_t half = s_traffic[t].num_values / 2;
+        aws_huffman_sampler_init(&samplers[0], 1);
+        aws_huffman_sampler_init(&samplers[1], 1);
+        ASSERT_SUCCESS(s_sample_values(&samplers[0], s_traffic[t].values, half));
+        ASSERT_SUCCESS(s_sample_values(&samplers[1], s_traffic[t].values + half, s_traffic[t].num_values - half));
+        aws_huffman_histogram_add_sampler(&histogram, &samplers[0]);
+        aws_huffman_histogram_add_sampler(&histogram, &samplers[1]);
+
+        struct aws_huffman_entropy_report report;
+        ASSERT_SUCCESS(aws_huffman_histogram_report(&histogram, test_get_coder(), &report));
+        ASSERT_TRUE(report.optimal_bits < report.coder_bits);
+
+        for (uint8_t max_code_length = 4; max_code_length <= 12; ++max_code_length) {
+            uint8_t code_lengths[256];
+            ASSERT_SUCCESS(aws_huffman_code_lengths_from_frequencies(histogram.counts, max_code_length, code_lengths));
+
+            struct aws_huffman_symbol_coder *coder = aws_huffman_coder_new_from_lengths(allocator, code_lengths);
+            ASSERT_NOT_NULL(coder);
+
+            for (size_t i = 0; i < s_traffic[t].num_values; ++i) {
+                const char *value = s_traffic[t].values[i];
+                const char *error_message = NULL;
+                ASSERT_SUCCESS(
+                    huffman_test_transitive(coder, value, strlen(value), 0, &error_message), error_message);
+                ASSERT_SUCCESS(
+                    huffman_test_transitive_chunked(coder, value, strlen(value), 0, 1, &error_message),
+                    error_message);
+            }
+            ASSERT_SUCCESS(s_test_sparse_coder_round_trip(coder, code_lengths));
+
+            aws_huffman_coder_destroy(coder);
+        }
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(huffman_assign_canonical_codes, test_huffman_assign_canonical_codes)
+static int test_huffman_assign_canonical_codes(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+    /* Test the example from RFC 1951 section 3.2.2 */
+
+    uint8_t code_lengths[256];
+    AWS_ZERO_ARRAY(code_lengths);
+    const uint8_t example_lengths[] = {3, 3, 3, 3, 3, 2, 4, 4};
+    const uint32_t example_codes[] = {0x2, 0x3, 0x4, 0x5, 0x6, 0x0, 0xe, 0xf};
+    for (size_t i = 0; i < sizeof(example_lengths); ++i) {
+        code_lengths['A' + i] = example_lengths[i];
+    }
+
+    struct aws_huffman_code codes[256];
+    ASSERT_SUCCESS(aws_huffman_assign_canonical_codes(code_lengths, codes));
+
+    for (size_t i = 0; i < sizeof(example_lengths); ++i) {
+        ASSERT_UINT_EQUALS(example_codes[i], codes['A' + i].pattern);
+        ASSERT_UINT_EQUALS(example_lengths[i], codes['A' + i].num_bits);
+    }
+    ASSERT_UINT_EQUALS(0, codes['I'].num_bits);
+
+    code_lengths['I'] = 1;
+    ASSERT_ERROR(AWS_ERROR_COMPRESSION_INVALID_CODE_LENGTHS, aws_huffman_assign_canonical_codes(code_lengths, codes));
+
     return AWS_OP_SUCCESS;
 }
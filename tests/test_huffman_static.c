@@ -14,272 +14,305 @@
  */
 
 /* WARNING: THIS FILE WAS AUTOMATICALLY GENERATED. DO NOT EDIT. */
+/* clang-format off */
 
+#include <aws/compression/error.h>
 #include <aws/compression/huffman.h>
+#include <aws/compression/huffman_static_coder.h>
+
+#include <aws/common/byte_order.h>
+#include <aws/common/error.h>
+
+#include <string.h>
+
+static const uint32_t packed_codes[] = {
+    0x72e, /* ' ' 0 */
+    0x72f, /* ' ' 1 */
+    0x730, /* ' ' 2 */
+    0x731, /* ' ' 3 */
+    0x732, /* ' ' 4 */
+    0x733, /* ' ' 5 */
+    0x734, /* ' ' 6 */
+    0x735, /* ' ' 7 */
+    0x736, /* ' ' 8 */
+    0x737, /* ' ' 9 */
+    0x1b8, /* ' ' 10 */
+    0x738, /* ' ' 11 */
+    0x739, /* ' ' 12 */
+    0x73a, /* ' ' 13 */
+    0x73b, /* ' ' 14 */
+    0x73c, /* ' ' 15 */
+    0x73d, /* ' ' 16 */
+    0x73e, /* ' ' 17 */
+    0x73f, /* ' ' 18 */
+    0x740, /* ' ' 19 */
+    0x741, /* ' ' 20 */
+    0x742, /* ' ' 21 */
+    0x743, /* ' ' 22 */
+    0x744, /* ' ' 23 */
+    0x745, /* ' ' 24 */
+    0x746, /* ' ' 25 */
+    0x747, /* ' ' 26 */
+    0x748, /* ' ' 27 */
+    0x749, /* ' ' 28 */
+    0x74a, /* ' ' 29 */
+    0x74b, /* ' ' 30 */
+    0x74c, /* ' ' 31 */
+    0x24, /* ' ' 32 */
+    0x74d, /* '!' 33 */
+    0x74e, /* '"' 34 */
+    0x74f, /* '#' 35 */
+    0x750, /* '$' 36 */
+    0x751, /* '%' 37 */
+    0x752, /* '&' 38 */
+    0xd6, /* ''' 39 */
+    0x753, /* '(' 40 */
+    0x754, /* ')' 41 */
+    0x755, /* '*' 42 */
+    0x756, /* '+' 43 */
+    0x1b9, /* ',' 44 */
+    0x388, /* '-' 45 */
+    0xd7, /* '.' 46 */
+    0x757, /* '/' 47 */
+    0x758, /* '0' 48 */
+    0x759, /* '1' 49 */
+    0x75a, /* '2' 50 */
+    0x75b, /* '3' 51 */
+    0x75c, /* '4' 52 */
+    0x75d, /* '5' 53 */
+    0x75e, /* '6' 54 */
+    0x75f, /* '7' 55 */
+    0x760, /* '8' 56 */
+    0x761, /* '9' 57 */
+    0x762, /* ':' 58 */
+    0x763, /* ';' 59 */
+    0x764, /* '<' 60 */
+    0x765, /* '=' 61 */
+    0x766, /* '>' 62 */
+    0x1ba, /* '?' 63 */
+    0x767, /* '@' 64 */
+    0x768, /* 'A' 65 */
+    0x1bb, /* 'B' 66 */
+    0x389, /* 'C' 67 */
+    0x38a, /* 'D' 68 */
+    0x38b, /* 'E' 69 */
+    0x38c, /* 'F' 70 */
+    0x38d, /* 'G' 71 */
+    0x38e, /* 'H' 72 */
+    0x1bc, /* 'I' 73 */
+    0x769, /* 'J' 74 */
+    0x76a, /* 'K' 75 */
+    0x38f, /* 'L' 76 */
+    0x390, /* 'M' 77 */
+    0x76b, /* 'N' 78 */
+    0x76c, /* 'O' 79 */
+    0x391, /* 'P' 80 */
+    0x76d, /* 'Q' 81 */
+    0x76e, /* 'R' 82 */
+    0x76f, /* 'S' 83 */
+    0x1bd, /* 'T' 84 */
+    0x770, /* 'U' 85 */
+    0x392, /* 'V' 86 */
+    0x1be, /* 'W' 87 */
+    0x771, /* 'X' 88 */
+    0x393, /* 'Y' 89 */
+    0x772, /* 'Z' 90 */
+    0x773, /* '[' 91 */
+    0x774, /* '\' 92 */
+    0x775, /* ']' 93 */
+    0x776, /* '^' 94 */
+    0x777, /* '_' 95 */
+    0x778, /* '`' 96 */
+    0x25, /* 'a' 97 */
+    0xd8, /* 'b' 98 */
+    0x60, /* 'c' 99 */
+    0x61, /* 'd' 100 */
+    0x26, /* 'e' 101 */
+    0x62, /* 'f' 102 */
+    0xd9, /* 'g' 103 */
+    0x63, /* 'h' 104 */
+    0x27, /* 'i' 105 */
+    0x1bf, /* 'j' 106 */
+    0x64, /* 'k' 107 */
+    0x65, /* 'l' 108 */
+    0x66, /* 'm' 109 */
+    0x28, /* 'n' 110 */
+    0x29, /* 'o' 111 */
+    0xda, /* 'p' 112 */
+    0x394, /* 'q' 113 */
+    0x2a, /* 'r' 114 */
+    0x2b, /* 's' 115 */
+    0x2c, /* 't' 116 */
+    0x2d, /* 'u' 117 */
+    0x1c0, /* 'v' 118 */
+    0x67, /* 'w' 119 */
+    0x1c1, /* 'x' 120 */
+    0x68, /* 'y' 121 */
+    0x779, /* 'z' 122 */
+    0x77a, /* '{' 123 */
+    0x77b, /* '|' 124 */
+    0x77c, /* '}' 125 */
+    0x77d, /* '~' 126 */
+    0x77e, /* ' ' 127 */
+    0x77f, /* ' ' 128 */
+    0x780, /* ' ' 129 */
+    0x781, /* ' ' 130 */
+    0x782, /* ' ' 131 */
+    0x783, /* ' ' 132 */
+    0x784, /* ' ' 133 */
+    0x785, /* ' ' 134 */
+    0x786, /* ' ' 135 */
+    0x787, /* ' ' 136 */
+    0x788, /* ' ' 137 */
+    0x789, /* ' ' 138 */
+    0x78a, /* ' ' 139 */
+    0x78b, /* ' ' 140 */
+    0x78c, /* ' ' 141 */
+    0x78d, /* ' ' 142 */
+    0x78e, /* ' ' 143 */
+    0x78f, /* ' ' 144 */
+    0x790, /* ' ' 145 */
+    0x791, /* ' ' 146 */
+    0x792, /* ' ' 147 */
+    0x793, /* ' ' 148 */
+    0x794, /* ' ' 149 */
+    0x795, /* ' ' 150 */
+    0x796, /* ' ' 151 */
+    0x797, /* ' ' 152 */
+    0x798, /* ' ' 153 */
+    0x799, /* ' ' 154 */
+    0x79a, /* ' ' 155 */
+    0x79b, /* ' ' 156 */
+    0x79c, /* ' ' 157 */
+    0x79d, /* ' ' 158 */
+    0x79e, /* ' ' 159 */
+    0x79f, /* ' ' 160 */
+    0x7a0, /* ' ' 161 */
+    0x7a1, /* ' ' 162 */
+    0x7a2, /* ' ' 163 */
+    0x7a3, /* ' ' 164 */
+    0x7a4, /* ' ' 165 */
+    0x7a5, /* ' ' 166 */
+    0x7a6, /* ' ' 167 */
+    0x7a7, /* ' ' 168 */
+    0x7a8, /* ' ' 169 */
+    0x7a9, /* ' ' 170 */
+    0x7aa, /* ' ' 171 */
+    0x7ab, /* ' ' 172 */
+    0x7ac, /* ' ' 173 */
+    0x7ad, /* ' ' 174 */
+    0x7ae, /* ' ' 175 */
+    0x7af, /* ' ' 176 */
+    0x7b0, /* ' ' 177 */
+    0x7b1, /* ' ' 178 */
+    0x7b2, /* ' ' 179 */
+    0x7b3, /* ' ' 180 */
+    0x7b4, /* ' ' 181 */
+    0x7b5, /* ' ' 182 */
+    0x7b6, /* ' ' 183 */
+    0x7b7, /* ' ' 184 */
+    0x7b8, /* ' ' 185 */
+    0x7b9, /* ' ' 186 */
+    0x7ba, /* ' ' 187 */
+    0x7bb, /* ' ' 188 */
+    0x7bc, /* ' ' 189 */
+    0x7bd, /* ' ' 190 */
+    0x7be, /* ' ' 191 */
+    0x7bf, /* ' ' 192 */
+    0x7c0, /* ' ' 193 */
+    0x7c1, /* ' ' 194 */
+    0x7c2, /* ' ' 195 */
+    0x7c3, /* ' ' 196 */
+    0x7c4, /* ' ' 197 */
+    0x7c5, /* ' ' 198 */
+    0x7c6, /* ' ' 199 */
+    0x7c7, /* ' ' 200 */
+    0x7c8, /* ' ' 201 */
+    0x7c9, /* ' ' 202 */
+    0x7ca, /* ' ' 203 */
+    0x7cb, /* ' ' 204 */
+    0x7cc, /* ' ' 205 */
+    0x7cd, /* ' ' 206 */
+    0x7ce, /* ' ' 207 */
+    0x7cf, /* ' ' 208 */
+    0x7d0, /* ' ' 209 */
+    0x7d1, /* ' ' 210 */
+    0x7d2, /* ' ' 211 */
+    0x7d3, /* ' ' 212 */
+    0x7d4, /* ' ' 213 */
+    0x7d5, /* ' ' 214 */
+    0x7d6, /* ' ' 215 */
+    0x7d7, /* ' ' 216 */
+    0x7d8, /* ' ' 217 */
+    0x7d9, /* ' ' 218 */
+    0x7da, /* ' ' 219 */
+    0x7db, /* ' ' 220 */
+    0x7dc, /* ' ' 221 */
+    0x7dd, /* ' ' 222 */
+    0x7de, /* ' ' 223 */
+    0x7df, /* ' ' 224 */
+    0x7e0, /* ' ' 225 */
+    0x7e1, /* ' ' 226 */
+    0x7e2, /* ' ' 227 */
+    0x7e3, /* ' ' 228 */
+    0x7e4, /* ' ' 229 */
+    0x7e5, /* ' ' 230 */
+    0x7e6, /* ' ' 231 */
+    0x7e7, /* ' ' 232 */
+    0x7e8, /* ' ' 233 */
+    0x7e9, /* ' ' 234 */
+    0x7ea, /* ' ' 235 */
+    0x7eb, /* ' ' 236 */
+    0x7ec, /* ' ' 237 */
+    0x7ed, /* ' ' 238 */
+    0x7ee, /* ' ' 239 */
+    0x7ef, /* ' ' 240 */
+    0x7f0, /* ' ' 241 */
+    0x7f1, /* ' ' 242 */
+    0x7f2, /* ' ' 243 */
+    0x7f3, /* ' ' 244 */
+    0x7f4, /* ' ' 245 */
+    0x7f5, /* ' ' 246 */
+    0x7f6, /* ' ' 247 */
+    0x7f7, /* ' ' 248 */
+    0x7f8, /* ' ' 249 */
+    0x7f9, /* ' ' 250 */
+    0x7fa, /* ' ' 251 */
+    0x7fb, /* ' ' 252 */
+    0x7fc, /* ' ' 253 */
+    0x7fd, /* ' ' 254 */
+    0x7fe, /* ' ' 255 */
+};
 
-static struct aws_huffman_code code_points[] = {
-    {.pattern = 0x32e, .num_bits = 10}, /* ' ' 0 */
-    {.pattern = 0x32f, .num_bits = 10}, /* ' ' 1 */
-    {.pattern = 0x330, .num_bits = 10}, /* ' ' 2 */
-    {.pattern = 0x331, .num_bits = 10}, /* ' ' 3 */
-    {.pattern = 0x332, .num_bits = 10}, /* ' ' 4 */
-    {.pattern = 0x333, .num_bits = 10}, /* ' ' 5 */
-    {.pattern = 0x334, .num_bits = 10}, /* ' ' 6 */
-    {.pattern = 0x335, .num_bits = 10}, /* ' ' 7 */
-    {.pattern = 0x336, .num_bits = 10}, /* ' ' 8 */
-    {.pattern = 0x337, .num_bits = 10}, /* ' ' 9 */
-    {.pattern = 0xb8, .num_bits = 8},   /* ' ' 10 */
-    {.pattern = 0x338, .num_bits = 10}, /* ' ' 11 */
-    {.pattern = 0x339, .num_bits = 10}, /* ' ' 12 */
-    {.pattern = 0x33a, .num_bits = 10}, /* ' ' 13 */
-    {.pattern = 0x33b, .num_bits = 10}, /* ' ' 14 */
-    {.pattern = 0x33c, .num_bits = 10}, /* ' ' 15 */
-    {.pattern = 0x33d, .num_bits = 10}, /* ' ' 16 */
-    {.pattern = 0x33e, .num_bits = 10}, /* ' ' 17 */
-    {.pattern = 0x33f, .num_bits = 10}, /* ' ' 18 */
-    {.pattern = 0x340, .num_bits = 10}, /* ' ' 19 */
-    {.pattern = 0x341, .num_bits = 10}, /* ' ' 20 */
-    {.pattern = 0x342, .num_bits = 10}, /* ' ' 21 */
-    {.pattern = 0x343, .num_bits = 10}, /* ' ' 22 */
-    {.pattern = 0x344, .num_bits = 10}, /* ' ' 23 */
-    {.pattern = 0x345, .num_bits = 10}, /* ' ' 24 */
-    {.pattern = 0x346, .num_bits = 10}, /* ' ' 25 */
-    {.pattern = 0x347, .num_bits = 10}, /* ' ' 26 */
-    {.pattern = 0x348, .num_bits = 10}, /* ' ' 27 */
-    {.pattern = 0x349, .num_bits = 10}, /* ' ' 28 */
-    {.pattern = 0x34a, .num_bits = 10}, /* ' ' 29 */
-    {.pattern = 0x34b, .num_bits = 10}, /* ' ' 30 */
-    {.pattern = 0x34c, .num_bits = 10}, /* ' ' 31 */
-    {.pattern = 0x4, .num_bits = 5},    /* ' ' 32 */
-    {.pattern = 0x34d, .num_bits = 10}, /* '!' 33 */
-    {.pattern = 0x34e, .num_bits = 10}, /* '"' 34 */
-    {.pattern = 0x34f, .num_bits = 10}, /* '#' 35 */
-    {.pattern = 0x350, .num_bits = 10}, /* '$' 36 */
-    {.pattern = 0x351, .num_bits = 10}, /* '%' 37 */
-    {.pattern = 0x352, .num_bits = 10}, /* '&' 38 */
-    {.pattern = 0x56, .num_bits = 7},   /* ''' 39 */
-    {.pattern = 0x353, .num_bits = 10}, /* '(' 40 */
-    {.pattern = 0x354, .num_bits = 10}, /* ')' 41 */
-    {.pattern = 0x355, .num_bits = 10}, /* '*' 42 */
-    {.pattern = 0x356, .num_bits = 10}, /* '+' 43 */
-    {.pattern = 0xb9, .num_bits = 8},   /* ',' 44 */
-    {.pattern = 0x188, .num_bits = 9},  /* '-' 45 */
-    {.pattern = 0x57, .num_bits = 7},   /* '.' 46 */
-    {.pattern = 0x357, .num_bits = 10}, /* '/' 47 */
-    {.pattern = 0x358, .num_bits = 10}, /* '0' 48 */
-    {.pattern = 0x359, .num_bits = 10}, /* '1' 49 */
-    {.pattern = 0x35a, .num_bits = 10}, /* '2' 50 */
-    {.pattern = 0x35b, .num_bits = 10}, /* '3' 51 */
-    {.pattern = 0x35c, .num_bits = 10}, /* '4' 52 */
-    {.pattern = 0x35d, .num_bits = 10}, /* '5' 53 */
-    {.pattern = 0x35e, .num_bits = 10}, /* '6' 54 */
-    {.pattern = 0x35f, .num_bits = 10}, /* '7' 55 */
-    {.pattern = 0x360, .num_bits = 10}, /* '8' 56 */
-    {.pattern = 0x361, .num_bits = 10}, /* '9' 57 */
-    {.pattern = 0x362, .num_bits = 10}, /* ':' 58 */
-    {.pattern = 0x363, .num_bits = 10}, /* ';' 59 */
-    {.pattern = 0x364, .num_bits = 10}, /* '<' 60 */
-    {.pattern = 0x365, .num_bits = 10}, /* '=' 61 */
-    {.pattern = 0x366, .num_bits = 10}, /* '>' 62 */
-    {.pattern = 0xba, .num_bits = 8},   /* '?' 63 */
-    {.pattern = 0x367, .num_bits = 10}, /* '@' 64 */
-    {.pattern = 0x368, .num_bits = 10}, /* 'A' 65 */
-    {.pattern = 0xbb, .num_bits = 8},   /* 'B' 66 */
-    {.pattern = 0x189, .num_bits = 9},  /* 'C' 67 */
-    {.pattern = 0x18a, .num_bits = 9},  /* 'D' 68 */
-    {.pattern = 0x18b, .num_bits = 9},  /* 'E' 69 */
-    {.pattern = 0x18c, .num_bits = 9},  /* 'F' 70 */
-    {.pattern = 0x18d, .num_bits = 9},  /* 'G' 71 */
-    {.pattern = 0x18e, .num_bits = 9},  /* 'H' 72 */
-    {.pattern = 0xbc, .num_bits = 8},   /* 'I' 73 */
-    {.pattern = 0x369, .num_bits = 10}, /* 'J' 74 */
-    {.pattern = 0x36a, .num_bits = 10}, /* 'K' 75 */
-    {.pattern = 0x18f, .num_bits = 9},  /* 'L' 76 */
-    {.pattern = 0x190, .num_bits = 9},  /* 'M' 77 */
-    {.pattern = 0x36b, .num_bits = 10}, /* 'N' 78 */
-    {.pattern = 0x36c, .num_bits = 10}, /* 'O' 79 */
-    {.pattern = 0x191, .num_bits = 9},  /* 'P' 80 */
-    {.pattern = 0x36d, .num_bits = 10}, /* 'Q' 81 */
-    {.pattern = 0x36e, .num_bits = 10}, /* 'R' 82 */
-    {.pattern = 0x36f, .num_bits = 10}, /* 'S' 83 */
-    {.pattern = 0xbd, .num_bits = 8},   /* 'T' 84 */
-    {.pattern = 0x370, .num_bits = 10}, /* 'U' 85 */
-    {.pattern = 0x192, .num_bits = 9},  /* 'V' 86 */
-    {.pattern = 0xbe, .num_bits = 8},   /* 'W' 87 */
-    {.pattern = 0x371, .num_bits = 10}, /* 'X' 88 */
-    {.pattern = 0x193, .num_bits = 9},  /* 'Y' 89 */
-    {.pattern = 0x372, .num_bits = 10}, /* 'Z' 90 */
-    {.pattern = 0x373, .num_bits = 10}, /* '[' 91 */
-    {.pattern = 0x374, .num_bits = 10}, /* '\' 92 */
-    {.pattern = 0x375, .num_bits = 10}, /* ']' 93 */
-    {.pattern = 0x376, .num_bits = 10}, /* '^' 94 */
-    {.pattern = 0x377, .num_bits = 10}, /* '_' 95 */
-    {.pattern = 0x378, .num_bits = 10}, /* '`' 96 */
-    {.pattern = 0x5, .num_bits = 5},    /* 'a' 97 */
-    {.pattern = 0x58, .num_bits = 7},   /* 'b' 98 */
-    {.pattern = 0x20, .num_bits = 6},   /* 'c' 99 */
-    {.pattern = 0x21, .num_bits = 6},   /* 'd' 100 */
-    {.pattern = 0x6, .num_bits = 5},    /* 'e' 101 */
-    {.pattern = 0x22, .num_bits = 6},   /* 'f' 102 */
-    {.pattern = 0x59, .num_bits = 7},   /* 'g' 103 */
-    {.pattern = 0x23, .num_bits = 6},   /* 'h' 104 */
-    {.pattern = 0x7, .num_bits = 5},    /* 'i' 105 */
-    {.pattern = 0xbf, .num_bits = 8},   /* 'j' 106 */
-    {.pattern = 0x24, .num_bits = 6},   /* 'k' 107 */
-    {.pattern = 0x25, .num_bits = 6},   /* 'l' 108 */
-    {.pattern = 0x26, .num_bits = 6},   /* 'm' 109 */
-    {.pattern = 0x8, .num_bits = 5},    /* 'n' 110 */
-    {.pattern = 0x9, .num_bits = 5},    /* 'o' 111 */
-    {.pattern = 0x5a, .num_bits = 7},   /* 'p' 112 */
-    {.pattern = 0x194, .num_bits = 9},  /* 'q' 113 */
-    {.pattern = 0xa, .num_bits = 5},    /* 'r' 114 */
-    {.pattern = 0xb, .num_bits = 5},    /* 's' 115 */
-    {.pattern = 0xc, .num_bits = 5},    /* 't' 116 */
-    {.pattern = 0xd, .num_bits = 5},    /* 'u' 117 */
-    {.pattern = 0xc0, .num_bits = 8},   /* 'v' 118 */
-    {.pattern = 0x27, .num_bits = 6},   /* 'w' 119 */
-    {.pattern = 0xc1, .num_bits = 8},   /* 'x' 120 */
-    {.pattern = 0x28, .num_bits = 6},   /* 'y' 121 */
-    {.pattern = 0x379, .num_bits = 10}, /* 'z' 122 */
-    {.pattern = 0x37a, .num_bits = 10}, /* '{' 123 */
-    {.pattern = 0x37b, .num_bits = 10}, /* '|' 124 */
-    {.pattern = 0x37c, .num_bits = 10}, /* '}' 125 */
-    {.pattern = 0x37d, .num_bits = 10}, /* '~' 126 */
-    {.pattern = 0x37e, .num_bits = 10}, /* ' ' 127 */
-    {.pattern = 0x37f, .num_bits = 10}, /* ' ' 128 */
-    {.pattern = 0x380, .num_bits = 10}, /* ' ' 129 */
-    {.pattern = 0x381, .num_bits = 10}, /* ' ' 130 */
-    {.pattern = 0x382, .num_bits = 10}, /* ' ' 131 */
-    {.pattern = 0x383, .num_bits = 10}, /* ' ' 132 */
-    {.pattern = 0x384, .num_bits = 10}, /* ' ' 133 */
-    {.pattern = 0x385, .num_bits = 10}, /* ' ' 134 */
-    {.pattern = 0x386, .num_bits = 10}, /* ' ' 135 */
-    {.pattern = 0x387, .num_bits = 10}, /* ' ' 136 */
-    {.pattern = 0x388, .num_bits = 10}, /* ' ' 137 */
-    {.pattern = 0x389, .num_bits = 10}, /* ' ' 138 */
-    {.pattern = 0x38a, .num_bits = 10}, /* ' ' 139 */
-    {.pattern = 0x38b, .num_bits = 10}, /* ' ' 140 */
-    {.pattern = 0x38c, .num_bits = 10}, /* ' ' 141 */
-    {.pattern = 0x38d, .num_bits = 10}, /* ' ' 142 */
-    {.pattern = 0x38e, .num_bits = 10}, /* ' ' 143 */
-    {.pattern = 0x38f, .num_bits = 10}, /* ' ' 144 */
-    {.pattern = 0x390, .num_bits = 10}, /* ' ' 145 */
-    {.pattern = 0x391, .num_bits = 10}, /* ' ' 146 */
-    {.pattern = 0x392, .num_bits = 10}, /* ' ' 147 */
-    {.pattern = 0x393, .num_bits = 10}, /* ' ' 148 */
-    {.pattern = 0x394, .num_bits = 10}, /* ' ' 149 */
-    {.pattern = 0x395, .num_bits = 10}, /* ' ' 150 */
-    {.pattern = 0x396, .num_bits = 10}, /* ' ' 151 */
-    {.pattern = 0x397, .num_bits = 10}, /* ' ' 152 */
-    {.pattern = 0x398, .num_bits = 10}, /* ' ' 153 */
-    {.pattern = 0x399, .num_bits = 10}, /* ' ' 154 */
-    {.pattern = 0x39a, .num_bits = 10}, /* ' ' 155 */
-    {.pattern = 0x39b, .num_bits = 10}, /* ' ' 156 */
-    {.pattern = 0x39c, .num_bits = 10}, /* ' ' 157 */
-    {.pattern = 0x39d, .num_bits = 10}, /* ' ' 158 */
-    {.pattern = 0x39e, .num_bits = 10}, /* ' ' 159 */
-    {.pattern = 0x39f, .num_bits = 10}, /* ' ' 160 */
-    {.pattern = 0x3a0, .num_bits = 10}, /* ' ' 161 */
-    {.pattern = 0x3a1, .num_bits = 10}, /* ' ' 162 */
-    {.pattern = 0x3a2, .num_bits = 10}, /* ' ' 163 */
-    {.pattern = 0x3a3, .num_bits = 10}, /* ' ' 164 */
-    {.pattern = 0x3a4, .num_bits = 10}, /* ' ' 165 */
-    {.pattern = 0x3a5, .num_bits = 10}, /* ' ' 166 */
-    {.pattern = 0x3a6, .num_bits = 10}, /* ' ' 167 */
-    {.pattern = 0x3a7, .num_bits = 10}, /* ' ' 168 */
-    {.pattern = 0x3a8, .num_bits = 10}, /* ' ' 169 */
-    {.pattern = 0x3a9, .num_bits = 10}, /* ' ' 170 */
-    {.pattern = 0x3aa, .num_bits = 10}, /* ' ' 171 */
-    {.pattern = 0x3ab, .num_bits = 10}, /* ' ' 172 */
-    {.pattern = 0x3ac, .num_bits = 10}, /* ' ' 173 */
-    {.pattern = 0x3ad, .num_bits = 10}, /* ' ' 174 */
-    {.pattern = 0x3ae, .num_bits = 10}, /* ' ' 175 */
-    {.pattern = 0x3af, .num_bits = 10}, /* ' ' 176 */
-    {.pattern = 0x3b0, .num_bits = 10}, /* ' ' 177 */
-    {.pattern = 0x3b1, .num_bits = 10}, /* ' ' 178 */
-    {.pattern = 0x3b2, .num_bits = 10}, /* ' ' 179 */
-    {.pattern = 0x3b3, .num_bits = 10}, /* ' ' 180 */
-    {.pattern = 0x3b4, .num_bits = 10}, /* ' ' 181 */
-    {.pattern = 0x3b5, .num_bits = 10}, /* ' ' 182 */
-    {.pattern = 0x3b6, .num_bits = 10}, /* ' ' 183 */
-    {.pattern = 0x3b7, .num_bits = 10}, /* ' ' 184 */
-    {.pattern = 0x3b8, .num_bits = 10}, /* ' ' 185 */
-    {.pattern = 0x3b9, .num_bits = 10}, /* ' ' 186 */
-    {.pattern = 0x3ba, .num_bits = 10}, /* ' ' 187 */
-    {.pattern = 0x3bb, .num_bits = 10}, /* ' ' 188 */
-    {.pattern = 0x3bc, .num_bits = 10}, /* ' ' 189 */
-    {.pattern = 0x3bd, .num_bits = 10}, /* ' ' 190 */
-    {.pattern = 0x3be, .num_bits = 10}, /* ' ' 191 */
-    {.pattern = 0x3bf, .num_bits = 10}, /* ' ' 192 */
-    {.pattern = 0x3c0, .num_bits = 10}, /* ' ' 193 */
-    {.pattern = 0x3c1, .num_bits = 10}, /* ' ' 194 */
-    {.pattern = 0x3c2, .num_bits = 10}, /* ' ' 195 */
-    {.pattern = 0x3c3, .num_bits = 10}, /* ' ' 196 */
-    {.pattern = 0x3c4, .num_bits = 10}, /* ' ' 197 */
-    {.pattern = 0x3c5, .num_bits = 10}, /* ' ' 198 */
-    {.pattern = 0x3c6, .num_bits = 10}, /* ' ' 199 */
-    {.pattern = 0x3c7, .num_bits = 10}, /* ' ' 200 */
-    {.pattern = 0x3c8, .num_bits = 10}, /* ' ' 201 */
-    {.pattern = 0x3c9, .num_bits = 10}, /* ' ' 202 */
-    {.pattern = 0x3ca, .num_bits = 10}, /* ' ' 203 */
-    {.pattern = 0x3cb, .num_bits = 10}, /* ' ' 204 */
-    {.pattern = 0x3cc, .num_bits = 10}, /* ' ' 205 */
-    {.pattern = 0x3cd, .num_bits = 10}, /* ' ' 206 */
-    {.pattern = 0x3ce, .num_bits = 10}, /* ' ' 207 */
-    {.pattern = 0x3cf, .num_bits = 10}, /* ' ' 208 */
-    {.pattern = 0x3d0, .num_bits = 10}, /* ' ' 209 */
-    {.pattern = 0x3d1, .num_bits = 10}, /* ' ' 210 */
-    {.pattern = 0x3d2, .num_bits = 10}, /* ' ' 211 */
-    {.pattern = 0x3d3, .num_bits = 10}, /* ' ' 212 */
-    {.pattern = 0x3d4, .num_bits = 10}, /* ' ' 213 */
-    {.pattern = 0x3d5, .num_bits = 10}, /* ' ' 214 */
-    {.pattern = 0x3d6, .num_bits = 10}, /* ' ' 215 */
-    {.pattern = 0x3d7, .num_bits = 10}, /* ' ' 216 */
-    {.pattern = 0x3d8, .num_bits = 10}, /* ' ' 217 */
-    {.pattern = 0x3d9, .num_bits = 10}, /* ' ' 218 */
-    {.pattern = 0x3da, .num_bits = 10}, /* ' ' 219 */
-    {.pattern = 0x3db, .num_bits = 10}, /* ' ' 220 */
-    {.pattern = 0x3dc, .num_bits = 10}, /* ' ' 221 */
-    {.pattern = 0x3dd, .num_bits = 10}, /* ' ' 222 */
-    {.pattern = 0x3de, .num_bits = 10}, /* ' ' 223 */
-    {.pattern = 0x3df, .num_bits = 10}, /* ' ' 224 */
-    {.pattern = 0x3e0, .num_bits = 10}, /* ' ' 225 */
-    {.pattern = 0x3e1, .num_bits = 10}, /* ' ' 226 */
-    {.pattern = 0x3e2, .num_bits = 10}, /* ' ' 227 */
-    {.pattern = 0x3e3, .num_bits = 10}, /* ' ' 228 */
-    {.pattern = 0x3e4, .num_bits = 10}, /* ' ' 229 */
-    {.pattern = 0x3e5, .num_bits = 10}, /* ' ' 230 */
-    {.pattern = 0x3e6, .num_bits = 10}, /* ' ' 231 */
-    {.pattern = 0x3e7, .num_bits = 10}, /* ' ' 232 */
-    {.pattern = 0x3e8, .num_bits = 10}, /* ' ' 233 */
-    {.pattern = 0x3e9, .num_bits = 10}, /* ' ' 234 */
-    {.pattern = 0x3ea, .num_bits = 10}, /* ' ' 235 */
-    {.pattern = 0x3eb, .num_bits = 10}, /* ' ' 236 */
-    {.pattern = 0x3ec, .num_bits = 10}, /* ' ' 237 */
-    {.pattern = 0x3ed, .num_bits = 10}, /* ' ' 238 */
-    {.pattern = 0x3ee, .num_bits = 10}, /* ' ' 239 */
-    {.pattern = 0x3ef, .num_bits = 10}, /* ' ' 240 */
-    {.pattern = 0x3f0, .num_bits = 10}, /* ' ' 241 */
-    {.pattern = 0x3f1, .num_bits = 10}, /* ' ' 242 */
-    {.pattern = 0x3f2, .num_bits = 10}, /* ' ' 243 */
-    {.pattern = 0x3f3, .num_bits = 10}, /* ' ' 244 */
-    {.pattern = 0x3f4, .num_bits = 10}, /* ' ' 245 */
-    {.pattern = 0x3f5, .num_bits = 10}, /* ' ' 246 */
-    {.pattern = 0x3f6, .num_bits = 10}, /* ' ' 247 */
-    {.pattern = 0x3f7, .num_bits = 10}, /* ' ' 248 */
-    {.pattern = 0x3f8, .num_bits = 10}, /* ' ' 249 */
-    {.pattern = 0x3f9, .num_bits = 10}, /* ' ' 250 */
-    {.pattern = 0x3fa, .num_bits = 10}, /* ' ' 251 */
-    {.pattern = 0x3fb, .num_bits = 10}, /* ' ' 252 */
-    {.pattern = 0x3fc, .num_bits = 10}, /* ' ' 253 */
-    {.pattern = 0x3fd, .num_bits = 10}, /* ' ' 254 */
-    {.pattern = 0x3fe, .num_bits = 10}, /* ' ' 255 */
+static const uint8_t code_lengths[] = {
+    10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 8, 10, 10, 10, 10, 10,
+    10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10,
+    5, 10, 10, 10, 10, 10, 10, 7, 10, 10, 10, 10, 8, 9, 7, 10,
+    10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 8,
+    10, 10, 8, 9, 9, 9, 9, 9, 9, 8, 10, 10, 9, 9, 10, 10,
+    9, 10, 10, 10, 8, 10, 9, 8, 10, 9, 10, 10, 10, 10, 10, 10,
+    10, 5, 7, 6, 6, 5, 6, 7, 6, 5, 8, 6, 6, 6, 5, 5,
+    7, 9, 5, 5, 5, 5, 8, 6, 8, 6, 10, 10, 10, 10, 10, 10,
+    10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10,
+    10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10,
+    10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10,
+    10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10,
+    10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10,
+    10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10,
+    10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10,
+    10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10,
 };
 
 static struct aws_huffman_code encode_symbol(uint8_t symbol, void *userdata) {
     (void)userdata;
 
-    return code_points[symbol];
+    struct aws_huffman_code code_point = {0};
+    const uint32_t packed = packed_codes[symbol];
+    if (packed) {
+        code_point.num_bits = AWS_HUFFMAN_PACKED_NUM_BITS(packed);
+        code_point.pattern = AWS_HUFFMAN_PACKED_PATTERN(packed, code_point.num_bits);
+    }
+    return code_point;
 }
 
 /* NOLINTNEXTLINE(readability-function-size) */
@@ -2388,6 +2421,84 @@ node_111111111:
         *symbol = 255;
         return 10;
     }
+
+}
+
+static enum aws_huffman_status decode_buffer(
+    struct aws_huffman_decoder *decoder,
+    struct aws_byte_cursor *to_decode,
+    struct aws_byte_buf *output,
+    void *userdata) {
+    (void)userdata;
+
+    uint64_t working_bits = decoder->working_bits;
+    uint8_t num_bits = decoder->num_bits;
+    const uint8_t *input = to_decode->ptr;
+    const uint8_t *input_end = to_decode->ptr + to_decode->len;
+    uint8_t *out = output->buffer + output->len;
+    uint8_t *out_end = output->buffer + output->capacity;
+
+    enum aws_huffman_status status = AWS_HUFFMAN_NEED_INPUT;
+    while (1) {
+        if (num_bits < 10) {
+            if (input_end - input >= (ptrdiff_t)sizeof(uint64_t)) {
+                /* Top up with a single unaligned big-endian load, keeping as many whole bytes as fit */
+                const uint8_t num_bytes = (63 - num_bits) / 8;
+                uint64_t new_bits = 0;
+                memcpy(&new_bits, input, sizeof(new_bits));
+                new_bits = aws_ntoh64(new_bits) & (UINT64_MAX << (64 - num_bytes * 8));
+
+                working_bits |= new_bits >> num_bits;
+                num_bits += num_bytes * 8;
+                input += num_bytes;
+            } else {
+                while (num_bits <= 56 && input != input_end) {
+                    working_bits |= (uint64_t)*input++ << (56 - num_bits);
+                    num_bits += 8;
+                }
+            }
+        }
+
+        if (num_bits == 0) {
+            /* Successfully decoded whole buffer */
+            break;
+        }
+
+        const uint32_t bits = (uint32_t)(working_bits >> 32);
+
+        uint8_t symbol = 0;
+        const uint8_t bits_read = decode_symbol(bits, &symbol, NULL);
+
+        if (bits_read == 0) {
+            if (input == input_end && num_bits < 10) {
+                /* More input is needed to continue */
+                break;
+            }
+            /* Unknown symbol found */
+            aws_raise_error(AWS_ERROR_COMPRESSION_UNKNOWN_SYMBOL);
+            status = AWS_HUFFMAN_ERROR;
+            break;
+        }
+        if (bits_read > num_bits) {
+            /* The rest of the input is part of a symbol that isn't complete yet */
+            break;
+        }
+        if (out == out_end) {
+            status = AWS_HUFFMAN_NEED_OUTPUT;
+            break;
+        }
+
+        working_bits <<= bits_read;
+        num_bits -= bits_read;
+        *out++ = symbol;
+    }
+
+    decoder->working_bits = working_bits;
+    decoder->num_bits = num_bits;
+    aws_byte_cursor_advance(to_decode, (size_t)(input - to_decode->ptr));
+    output->len = (size_t)(out - output->buffer);
+
+    return status;
 }
 
 struct aws_huffman_symbol_coder *test_get_coder(void) {
@@ -2395,7 +2506,14 @@ struct aws_huffman_symbol_coder *test_get_coder(void) {
     static struct aws_huffman_symbol_coder coder = {
         .encode = encode_symbol,
         .decode = decode_symbol,
+        .decode_buffer = decode_buffer,
         .userdata = NULL,
+        .code_lengths = code_lengths,
+        .min_code_length = 5,
+        .max_code_length = 10,
+        .packed_codes = packed_codes,
     };
     return &coder;
 }
+
+AWS_HUFFMAN_DEFINE_STATIC_CODER(test, packed_codes, decode_buffer)
@@ -0,0 +1,472 @@
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/* WARNING: THIS FILE WAS AUTOMATICALLY GENERATED. DO NOT EDIT. */
+/* clang-format off */
+
+#include <aws/compression/error.h>
+#include <aws/compression/huffman.h>
+#include <aws/compression/huffman_static_coder.h>
+
+#include <aws/common/byte_order.h>
+#include <aws/common/error.h>
+
+#include <string.h>
+
+static const uint32_t packed_codes[] = {
+    0x72e, /* ' ' 0 */
+    0x72f, /* ' ' 1 */
+    0x730, /* ' ' 2 */
+    0x731, /* ' ' 3 */
+    0x732, /* ' ' 4 */
+    0x733, /* ' ' 5 */
+    0x734, /* ' ' 6 */
+    0x735, /* ' ' 7 */
+    0x736, /* ' ' 8 */
+    0x737, /* ' ' 9 */
+    0x1b8, /* ' ' 10 */
+    0x738, /* ' ' 11 */
+    0x739, /* ' ' 12 */
+    0x73a, /* ' ' 13 */
+    0x73b, /* ' ' 14 */
+    0x73c, /* ' ' 15 */
+    0x73d, /* ' ' 16 */
+    0x73e, /* ' ' 17 */
+    0x73f, /* ' ' 18 */
+    0x740, /* ' ' 19 */
+    0x741, /* ' ' 20 */
+    0x742, /* ' ' 21 */
+    0x743, /* ' ' 22 */
+    0x744, /* ' ' 23 */
+    0x745, /* ' ' 24 */
+    0x746, /* ' ' 25 */
+    0x747, /* ' ' 26 */
+    0x748, /* ' ' 27 */
+    0x749, /* ' ' 28 */
+    0x74a, /* ' ' 29 */
+    0x74b, /* ' ' 30 */
+    0x74c, /* ' ' 31 */
+    0x24, /* ' ' 32 */
+    0x74d, /* '!' 33 */
+    0x74e, /* '"' 34 */
+    0x74f, /* '#' 35 */
+    0x750, /* '$' 36 */
+    0x751, /* '%' 37 */
+    0x752, /* '&' 38 */
+    0xd6, /* ''' 39 */
+    0x753, /* '(' 40 */
+    0x754, /* ')' 41 */
+    0x755, /* '*' 42 */
+    0x756, /* '+' 43 */
+    0x1b9, /* ',' 44 */
+    0x388, /* '-' 45 */
+    0xd7, /* '.' 46 */
+    0x757, /* '/' 47 */
+    0x758, /* '0' 48 */
+    0x759, /* '1' 49 */
+    0x75a, /* '2' 50 */
+    0x75b, /* '3' 51 */
+    0x75c, /* '4' 52 */
+    0x75d, /* '5' 53 */
+    0x75e, /* '6' 54 */
+    0x75f, /* '7' 55 */
+    0x760, /* '8' 56 */
+    0x761, /* '9' 57 */
+    0x762, /* ':' 58 */
+    0x763, /* ';' 59 */
+    0x764, /* '<' 60 */
+    0x765, /* '=' 61 */
+    0x766, /* '>' 62 */
+    0x1ba, /* '?' 63 */
+    0x767, /* '@' 64 */
+    0x768, /* 'A' 65 */
+    0x1bb, /* 'B' 66 */
+    0x389, /* 'C' 67 */
+    0x38a, /* 'D' 68 */
+    0x38b, /* 'E' 69 */
+    0x38c, /* 'F' 70 */
+    0x38d, /* 'G' 71 */
+    0x38e, /* 'H' 72 */
+    0x1bc, /* 'I' 73 */
+    0x769, /* 'J' 74 */
+    0x76a, /* 'K' 75 */
+    0x38f, /* 'L' 76 */
+    0x390, /* 'M' 77 */
+    0x76b, /* 'N' 78 */
+    0x76c, /* 'O' 79 */
+    0x391, /* 'P' 80 */
+    0x76d, /* 'Q' 81 */
+    0x76e, /* 'R' 82 */
+    0x76f, /* 'S' 83 */
+    0x1bd, /* 'T' 84 */
+    0x770, /* 'U' 85 */
+    0x392, /* 'V' 86 */
+    0x1be, /* 'W' 87 */
+    0x771, /* 'X' 88 */
+    0x393, /* 'Y' 89 */
+    0x772, /* 'Z' 90 */
+    0x773, /* '[' 91 */
+    0x774, /* '\' 92 */
+    0x775, /* ']' 93 */
+    0x776, /* '^' 94 */
+    0x777, /* '_' 95 */
+    0x778, /* '`' 96 */
+    0x25, /* 'a' 97 */
+    0xd8, /* 'b' 98 */
+    0x60, /* 'c' 99 */
+    0x61, /* 'd' 100 */
+    0x26, /* 'e' 101 */
+    0x62, /* 'f' 102 */
+    0xd9, /* 'g' 103 */
+    0x63, /* 'h' 104 */
+    0x27, /* 'i' 105 */
+    0x1bf, /* 'j' 106 */
+    0x64, /* 'k' 107 */
+    0x65, /* 'l' 108 */
+    0x66, /* 'm' 109 */
+    0x28, /* 'n' 110 */
+    0x29, /* 'o' 111 */
+    0xda, /* 'p' 112 */
+    0x394, /* 'q' 113 */
+    0x2a, /* 'r' 114 */
+    0x2b, /* 's' 115 */
+    0x2c, /* 't' 116 */
+    0x2d, /* 'u' 117 */
+    0x1c0, /* 'v' 118 */
+    0x67, /* 'w' 119 */
+    0x1c1, /* 'x' 120 */
+    0x68, /* 'y' 121 */
+    0x779, /* 'z' 122 */
+    0x77a, /* '{' 123 */
+    0x77b, /* '|' 124 */
+    0x77c, /* '}' 125 */
+    0x77d, /* '~' 126 */
+    0x77e, /* ' ' 127 */
+    0x77f, /* ' ' 128 */
+    0x780, /* ' ' 129 */
+    0x781, /* ' ' 130 */
+    0x782, /* ' ' 131 */
+    0x783, /* ' ' 132 */
+    0x784, /* ' ' 133 */
+    0x785, /* ' ' 134 */
+    0x786, /* ' ' 135 */
+    0x787, /* ' ' 136 */
+    0x788, /* ' ' 137 */
+    0x789, /* ' ' 138 */
+    0x78a, /* ' ' 139 */
+    0x78b, /* ' ' 140 */
+    0x78c, /* ' ' 141 */
+    0x78d, /* ' ' 142 */
+    0x78e, /* ' ' 143 */
+    0x78f, /* ' ' 144 */
+    0x790, /* ' ' 145 */
+    0x791, /* ' ' 146 */
+    0x792, /* ' ' 147 */
+    0x793, /* ' ' 148 */
+    0x794, /* ' ' 149 */
+    0x795, /* ' ' 150 */
+    0x796, /* ' ' 151 */
+    0x797, /* ' ' 152 */
+    0x798, /* ' ' 153 */
+    0x799, /* ' ' 154 */
+    0x79a, /* ' ' 155 */
+    0x79b, /* ' ' 156 */
+    0x79c, /* ' ' 157 */
+    0x79d, /* ' ' 158 */
+    0x79e, /* ' ' 159 */
+    0x79f, /* ' ' 160 */
+    0x7a0, /* ' ' 161 */
+    0x7a1, /* ' ' 162 */
+    0x7a2, /* ' ' 163 */
+    0x7a3, /* ' ' 164 */
+    0x7a4, /* ' ' 165 */
+    0x7a5, /* ' ' 166 */
+    0x7a6, /* ' ' 167 */
+    0x7a7, /* ' ' 168 */
+    0x7a8, /* ' ' 169 */
+    0x7a9, /* ' ' 170 */
+    0x7aa, /* ' ' 171 */
+    0x7ab, /* ' ' 172 */
+    0x7ac, /* ' ' 173 */
+    0x7ad, /* ' ' 174 */
+    0x7ae, /* ' ' 175 */
+    0x7af, /* ' ' 176 */
+    0x7b0, /* ' ' 177 */
+    0x7b1, /* ' ' 178 */
+    0x7b2, /* ' ' 179 */
+    0x7b3, /* ' ' 180 */
+    0x7b4, /* ' ' 181 */
+    0x7b5, /* ' ' 182 */
+    0x7b6, /* ' ' 183 */
+    0x7b7, /* ' ' 184 */
+    0x7b8, /* ' ' 185 */
+    0x7b9, /* ' ' 186 */
+    0x7ba, /* ' ' 187 */
+    0x7bb, /* ' ' 188 */
+    0x7bc, /* ' ' 189 */
+    0x7bd, /* ' ' 190 */
+    0x7be, /* ' ' 191 */
+    0x7bf, /* ' ' 192 */
+    0x7c0, /* ' ' 193 */
+    0x7c1, /* ' ' 194 */
+    0x7c2, /* ' ' 195 */
+    0x7c3, /* ' ' 196 */
+    0x7c4, /* ' ' 197 */
+    0x7c5, /* ' ' 198 */
+    0x7c6, /* ' ' 199 */
+    0x7c7, /* ' ' 200 */
+    0x7c8, /* ' ' 201 */
+    0x7c9, /* ' ' 202 */
+    0x7ca, /* ' ' 203 */
+    0x7cb, /* ' ' 204 */
+    0x7cc, /* ' ' 205 */
+    0x7cd, /* ' ' 206 */
+    0x7ce, /* ' ' 207 */
+    0x7cf, /* ' ' 208 */
+    0x7d0, /* ' ' 209 */
+    0x7d1, /* ' ' 210 */
+    0x7d2, /* ' ' 211 */
+    0x7d3, /* ' ' 212 */
+    0x7d4, /* ' ' 213 */
+    0x7d5, /* ' ' 214 */
+    0x7d6, /* ' ' 215 */
+    0x7d7, /* ' ' 216 */
+    0x7d8, /* ' ' 217 */
+    0x7d9, /* ' ' 218 */
+    0x7da, /* ' ' 219 */
+    0x7db, /* ' ' 220 */
+    0x7dc, /* ' ' 221 */
+    0x7dd, /* ' ' 222 */
+    0x7de, /* ' ' 223 */
+    0x7df, /* ' ' 224 */
+    0x7e0, /* ' ' 225 */
+    0x7e1, /* ' ' 226 */
+    0x7e2, /* ' ' 227 */
+    0x7e3, /* ' ' 228 */
+    0x7e4, /* ' ' 229 */
+    0x7e5, /* ' ' 230 */
+    0x7e6, /* ' ' 231 */
+    0x7e7, /* ' ' 232 */
+    0x7e8, /* ' ' 233 */
+    0x7e9, /* ' ' 234 */
+    0x7ea, /* ' ' 235 */
+    0x7eb, /* ' ' 236 */
+    0x7ec, /* ' ' 237 */
+    0x7ed, /* ' ' 238 */
+    0x7ee, /* ' ' 239 */
+    0x7ef, /* ' ' 240 */
+    0x7f0, /* ' ' 241 */
+    0x7f1, /* ' ' 242 */
+    0x7f2, /* ' ' 243 */
+    0x7f3, /* ' ' 244 */
+    0x7f4, /* ' ' 245 */
+    0x7f5, /* ' ' 246 */
+    0x7f6, /* ' ' 247 */
+    0x7f7, /* ' ' 248 */
+    0x7f8, /* ' ' 249 */
+    0x7f9, /* ' ' 250 */
+    0x7fa, /* ' ' 251 */
+    0x7fb, /* ' ' 252 */
+    0x7fc, /* ' ' 253 */
+    0x7fd, /* ' ' 254 */
+    0x7fe, /* ' ' 255 */
+};
+
+static const uint8_t code_lengths[] = {
+    10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 8, 10, 10, 10, 10, 10,
+    10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10,
+    5, 10, 10, 10, 10, 10, 10, 7, 10, 10, 10, 10, 8, 9, 7, 10,
+    10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 8,
+    10, 10, 8, 9, 9, 9, 9, 9, 9, 8, 10, 10, 9, 9, 10, 10,
+    9, 10, 10, 10, 8, 10, 9, 8, 10, 9, 10, 10, 10, 10, 10, 10,
+    10, 5, 7, 6, 6, 5, 6, 7, 6, 5, 8, 6, 6, 6, 5, 5,
+    7, 9, 5, 5, 5, 5, 8, 6, 8, 6, 10, 10, 10, 10, 10, 10,
+    10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10,
+    10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10,
+    10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10,
+    10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10,
+    10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10,
+    10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10,
+    10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10,
+    10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10,
+};
+
+static struct aws_huffman_code encode_symbol(uint8_t symbol, void *userdata) {
+    (void)userdata;
+
+    struct aws_huffman_code code_point = {0};
+    const uint32_t packed = packed_codes[symbol];
+    if (packed) {
+        code_point.num_bits = AWS_HUFFMAN_PACKED_NUM_BITS(packed);
+        code_point.pattern = AWS_HUFFMAN_PACKED_PATTERN(packed, code_point.num_bits);
+    }
+    return code_point;
+}
+
+/* Symbols ordered by code: 256 bytes */
+static const uint8_t sorted_symbols[] = {
+    32, 97, 101, 105, 110, 111, 114, 115, 116, 117, 99, 100, 102, 104, 107, 108,
+    109, 119, 121, 39, 46, 98, 103, 112, 10, 44, 63, 66, 73, 84, 87, 106,
+    118, 120, 45, 67, 68, 69, 70, 71, 72, 76, 77, 80, 86, 89, 113, 0,
+    1, 2, 3, 4, 5, 6, 7, 8, 9, 11, 12, 13, 14, 15, 16, 17,
+    18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 33, 34,
+    35, 36, 37, 38, 40, 41, 42, 43, 47, 48, 49, 50, 51, 52, 53, 54,
+    55, 56, 57, 58, 59, 60, 61, 62, 64, 65, 74, 75, 78, 79, 81, 82,
+    83, 85, 88, 90, 91, 92, 93, 94, 95, 96, 122, 123, 124, 125, 126, 127,
+    128, 129, 130, 131, 132, 133, 134, 135, 136, 137, 138, 139, 140, 141, 142, 143,
+    144, 145, 146, 147, 148, 149, 150, 151, 152, 153, 154, 155, 156, 157, 158, 159,
+    160, 161, 162, 163, 164, 165, 166, 167, 168, 169, 170, 171, 172, 173, 174, 175,
+    176, 177, 178, 179, 180, 181, 182, 183, 184, 185, 186, 187, 188, 189, 190, 191,
+    192, 193, 194, 195, 196, 197, 198, 199, 200, 201, 202, 203, 204, 205, 206, 207,
+    208, 209, 210, 211, 212, 213, 214, 215, 216, 217, 218, 219, 220, 221, 222, 223,
+    224, 225, 226, 227, 228, 229, 230, 231, 232, 233, 234, 235, 236, 237, 238, 239,
+    240, 241, 242, 243, 244, 245, 246, 247, 248, 249, 250, 251, 252, 253, 254, 255,
+};
+
+struct canonical_length {
+    uint64_t limit;
+    uint32_t first_code;
+    uint16_t first_index;
+    uint8_t num_bits;
+};
+
+/* { limit, first_code, first_index, num_bits }: 6 lengths, 96 bytes */
+static const struct canonical_length lengths[] = {
+    { 0x70000000ull, 4, 0, 5 },
+    { 0xa4000000ull, 32, 10, 6 },
+    { 0xb6000000ull, 86, 19, 7 },
+    { 0xc2000000ull, 184, 24, 8 },
+    { 0xca800000ull, 392, 34, 9 },
+    { 0xffc00000ull, 814, 47, 10 },
+};
+
+static uint8_t decode_symbol(uint32_t bits, uint8_t *symbol, void *userdata) {
+    (void)userdata;
+
+    /* The code's length is the first whose limit bits is below. Counting the limits bits is at or above
+       finds it without branching */
+    size_t index = 0;
+    for (size_t i = 0; i < 6; ++i) {
+        index += bits >= lengths[i].limit;
+    }
+    if (index == 6) {
+        /* Past the last code */
+        return 0;
+    }
+
+    const struct canonical_length *length = &lengths[index];
+    const uint32_t code = bits >> (32 - length->num_bits);
+    if (code < length->first_code) {
+        /* Between the last shorter code and the first code of this length */
+        return 0;
+    }
+
+    *symbol = sorted_symbols[length->first_index + (code - length->first_code)];
+    return length->num_bits;
+}
+
+static enum aws_huffman_status decode_buffer(
+    struct aws_huffman_decoder *decoder,
+    struct aws_byte_cursor *to_decode,
+    struct aws_byte_buf *output,
+    void *userdata) {
+    (void)userdata;
+
+    uint64_t working_bits = decoder->working_bits;
+    uint8_t num_bits = decoder->num_bits;
+    const uint8_t *input = to_decode->ptr;
+    const uint8_t *input_end = to_decode->ptr + to_decode->len;
+    uint8_t *out = output->buffer + output->len;
+    uint8_t *out_end = output->buffer + output->capacity;
+
+    enum aws_huffman_status status = AWS_HUFFMAN_NEED_INPUT;
+    while (1) {
+        if (num_bits < 10) {
+            if (input_end - input >= (ptrdiff_t)sizeof(uint64_t)) {
+                /* Top up with a single unaligned big-endian load, keeping as many whole bytes as fit */
+                const uint8_t num_bytes = (63 - num_bits) / 8;
+                uint64_t new_bits = 0;
+                memcpy(&new_bits, input, sizeof(new_bits));
+                new_bits = aws_ntoh64(new_bits) & (UINT64_MAX << (64 - num_bytes * 8));
+
+                working_bits |= new_bits >> num_bits;
+                num_bits += num_bytes * 8;
+                input += num_bytes;
+            } else {
+                while (num_bits <= 56 && input != input_end) {
+                    working_bits |= (uint64_t)*input++ << (56 - num_bits);
+                    num_bits += 8;
+                }
+            }
+        }
+
+        if (num_bits == 0) {
+            /* Successfully decoded whole buffer */
+            break;
+        }
+
+        const uint32_t bits = (uint32_t)(working_bits >> 32);
+
+        uint8_t symbol = 0;
+        const uint8_t bits_read = decode_symbol(bits, &symbol, NULL);
+
+        if (bits_read == 0) {
+            if (input == input_end && num_bits < 10) {
+                /* More input is needed to continue */
+                break;
+            }
+            /* Unknown symbol found */
+            aws_raise_error(AWS_ERROR_COMPRESSION_UNKNOWN_SYMBOL);
+            status = AWS_HUFFMAN_ERROR;
+            break;
+        }
+        if (bits_read > num_bits) {
+            /* The rest of the input is part of a symbol that isn't complete yet */
+            break;
+        }
+        if (out == out_end) {
+            status = AWS_HUFFMAN_NEED_OUTPUT;
+            break;
+        }
+
+        working_bits <<= bits_read;
+        num_bits -= bits_read;
+        *out++ = symbol;
+    }
+
+    decoder->working_bits = working_bits;
+    decoder->num_bits = num_bits;
+    aws_byte_cursor_advance(to_decode, (size_t)(input - to_decode->ptr));
+    output->len = (size_t)(out - output->buffer);
+
+    return status;
+}
+
+struct aws_huffman_symbol_coder *test_canonical_get_coder(void) {
+
+    static struct aws_huffman_symbol_coder coder = {
+        .encode = encode_symbol,
+        .decode = decode_symbol,
+        .decode_buffer = decode_buffer,
+        .userdata = NULL,
+        .code_lengths = code_lengths,
+        .min_code_length = 5,
+        .max_code_length = 10,
+        .packed_codes = packed_codes,
+    };
+    return &coder;
+}
+
+AWS_HUFFMAN_DEFINE_STATIC_CODER(test_canonical, packed_codes, decode_buffer)
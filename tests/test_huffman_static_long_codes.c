@@ -0,0 +1,496 @@
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/* WARNING: THIS FILE WAS AUTOMATICALLY GENERATED. DO NOT EDIT. */
+/* clang-format off */
+
+#include <aws/compression/error.h>
+#include <aws/compression/huffman.h>
+#include <aws/compression/huffman_static_coder.h>
+
+#include <aws/common/byte_order.h>
+#include <aws/common/error.h>
+
+#include <string.h>
+
+static const uint32_t packed_codes[] = {
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0xffffffe, /* 'A' 65 */
+    0x1ffffffe, /* 'B' 66 */
+    0x3ffffffe, /* 'C' 67 */
+    0x7ffffffe, /* 'D' 68 */
+    0xfffffffe, /* 'E' 69 */
+    0x0, /* 'F' 70 */
+    0x0, /* 'G' 71 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x2, /* 'a' 97 */
+    0x6, /* 'b' 98 */
+    0xe, /* 'c' 99 */
+    0x1e, /* 'd' 100 */
+    0x3e, /* 'e' 101 */
+    0x7e, /* 'f' 102 */
+    0xfe, /* 'g' 103 */
+    0x1fe, /* 'h' 104 */
+    0x3fe, /* 'i' 105 */
+    0x7fe, /* 'j' 106 */
+    0xffe, /* 'k' 107 */
+    0x1ffe, /* 'l' 108 */
+    0x3ffe, /* 'm' 109 */
+    0x7ffe, /* 'n' 110 */
+    0xfffe, /* 'o' 111 */
+    0x1fffe, /* 'p' 112 */
+    0x3fffe, /* 'q' 113 */
+    0x7fffe, /* 'r' 114 */
+    0xffffe, /* 's' 115 */
+    0x1ffffe, /* 't' 116 */
+    0x3ffffe, /* 'u' 117 */
+    0x7ffffe, /* 'v' 118 */
+    0xfffffe, /* 'w' 119 */
+    0x1fffffe, /* 'x' 120 */
+    0x3fffffe, /* 'y' 121 */
+    0x7fffffe, /* 'z' 122 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+    0x0, /* ' ' 0 */
+};
+
+static const uint8_t code_lengths[] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 27, 28, 29, 30, 31, 32, 32, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+    16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+static struct aws_huffman_code encode_symbol(uint8_t symbol, void *userdata) {
+    (void)userdata;
+
+    struct aws_huffman_code code_point = {0};
+    const uint32_t packed = packed_codes[symbol];
+    if (packed) {
+        code_point.num_bits = AWS_HUFFMAN_PACKED_NUM_BITS(packed);
+        code_point.pattern = AWS_HUFFMAN_PACKED_PATTERN(packed, code_point.num_bits);
+    }
+
+    switch (symbol) {
+        case 70:
+            code_point.pattern = 0xfffffffe;
+            code_point.num_bits = 32;
+            break;
+        case 71:
+            code_point.pattern = 0xffffffff;
+            code_point.num_bits = 32;
+            break;
+    }
+    return code_point;
+}
+
+/* Symbols ordered by code: 33 bytes */
+static const uint8_t sorted_symbols[] = {
+    97, 98, 99, 100, 101, 102, 103, 104, 105, 106, 107, 108, 109, 110, 111, 112,
+    113, 114, 115, 116, 117, 118, 119, 120, 121, 122, 65, 66, 67, 68, 69, 70,
+    71,
+};
+
+struct canonical_length {
+    uint64_t limit;
+    uint32_t first_code;
+    uint16_t first_index;
+    uint8_t num_bits;
+};
+
+/* { limit, first_code, first_index, num_bits }: 32 lengths, 512 bytes */
+static const struct canonical_length lengths[] = {
+    { 0x80000000ull, 0, 0, 1 },
+    { 0xc0000000ull, 2, 1, 2 },
+    { 0xe0000000ull, 6, 2, 3 },
+    { 0xf0000000ull, 14, 3, 4 },
+    { 0xf8000000ull, 30, 4, 5 },
+    { 0xfc000000ull, 62, 5, 6 },
+    { 0xfe000000ull, 126, 6, 7 },
+    { 0xff000000ull, 254, 7, 8 },
+    { 0xff800000ull, 510, 8, 9 },
+    { 0xffc00000ull, 1022, 9, 10 },
+    { 0xffe00000ull, 2046, 10, 11 },
+    { 0xfff00000ull, 4094, 11, 12 },
+    { 0xfff80000ull, 8190, 12, 13 },
+    { 0xfffc0000ull, 16382, 13, 14 },
+    { 0xfffe0000ull, 32766, 14, 15 },
+    { 0xffff0000ull, 65534, 15, 16 },
+    { 0xffff8000ull, 131070, 16, 17 },
+    { 0xffffc000ull, 262142, 17, 18 },
+    { 0xffffe000ull, 524286, 18, 19 },
+    { 0xfffff000ull, 1048574, 19, 20 },
+    { 0xfffff800ull, 2097150, 20, 21 },
+    { 0xfffffc00ull, 4194302, 21, 22 },
+    { 0xfffffe00ull, 8388606, 22, 23 },
+    { 0xffffff00ull, 16777214, 23, 24 },
+    { 0xffffff80ull, 33554430, 24, 25 },
+    { 0xffffffc0ull, 67108862, 25, 26 },
+    { 0xffffffe0ull, 134217726, 26, 27 },
+    { 0xfffffff0ull, 268435454, 27, 28 },
+    { 0xfffffff8ull, 536870910, 28, 29 },
+    { 0xfffffffcull, 1073741822, 29, 30 },
+    { 0xfffffffeull, 2147483646, 30, 31 },
+    { 0x100000000ull, 4294967294, 31, 32 },
+};
+
+static uint8_t decode_symbol(uint32_t bits, uint8_t *symbol, void *userdata) {
+    (void)userdata;
+
+    /* The code's length is the first whose limit bits is below. Counting the limits bits is at or above
+       finds it without branching */
+    size_t index = 0;
+    for (size_t i = 0; i < 32; ++i) {
+        index += bits >= lengths[i].limit;
+    }
+    if (index == 32) {
+        /* Past the last code */
+        return 0;
+    }
+
+    const struct canonical_length *length = &lengths[index];
+    const uint32_t code = bits >> (32 - length->num_bits);
+    if (code < length->first_code) {
+        /* Between the last shorter code and the first code of this length */
+        return 0;
+    }
+
+    *symbol = sorted_symbols[length->first_index + (code - length->first_code)];
+    return length->num_bits;
+}
+
+static enum aws_huffman_status decode_buffer(
+    struct aws_huffman_decoder *decoder,
+    struct aws_byte_cursor *to_decode,
+    struct aws_byte_buf *output,
+    void *userdata) {
+    (void)userdata;
+
+    uint64_t working_bits = decoder->working_bits;
+    uint8_t num_bits = decoder->num_bits;
+    const uint8_t *input = to_decode->ptr;
+    const uint8_t *input_end = to_decode->ptr + to_decode->len;
+    uint8_t *out = output->buffer + output->len;
+    uint8_t *out_end = output->buffer + output->capacity;
+
+    enum aws_huffman_status status = AWS_HUFFMAN_NEED_INPUT;
+    while (1) {
+        if (num_bits < 32) {
+            if (input_end - input >= (ptrdiff_t)sizeof(uint64_t)) {
+                /* Top up with a single unaligned big-endian load, keeping as many whole bytes as fit */
+                const uint8_t num_bytes = (63 - num_bits) / 8;
+                uint64_t new_bits = 0;
+                memcpy(&new_bits, input, sizeof(new_bits));
+                new_bits = aws_ntoh64(new_bits) & (UINT64_MAX << (64 - num_bytes * 8));
+
+                working_bits |= new_bits >> num_bits;
+                num_bits += num_bytes * 8;
+                input += num_bytes;
+            } else {
+                while (num_bits <= 56 && input != input_end) {
+                    working_bits |= (uint64_t)*input++ << (56 - num_bits);
+                    num_bits += 8;
+                }
+            }
+        }
+
+        if (num_bits == 0) {
+            /* Successfully decoded whole buffer */
+            break;
+        }
+
+        const uint32_t bits = (uint32_t)(working_bits >> 32);
+
+        uint8_t symbol = 0;
+        const uint8_t bits_read = decode_symbol(bits, &symbol, NULL);
+
+        if (bits_read == 0) {
+            if (input == input_end && num_bits < 32) {
+                /* More input is needed to continue */
+                break;
+            }
+            /* Unknown symbol found */
+            aws_raise_error(AWS_ERROR_COMPRESSION_UNKNOWN_SYMBOL);
+            status = AWS_HUFFMAN_ERROR;
+            break;
+        }
+        if (bits_read > num_bits) {
+            /* The rest of the input is part of a symbol that isn't complete yet */
+            break;
+        }
+        if (out == out_end) {
+            status = AWS_HUFFMAN_NEED_OUTPUT;
+            break;
+        }
+
+        working_bits <<= bits_read;
+        num_bits -= bits_read;
+        *out++ = symbol;
+    }
+
+    decoder->working_bits = working_bits;
+    decoder->num_bits = num_bits;
+    aws_byte_cursor_advance(to_decode, (size_t)(input - to_decode->ptr));
+    output->len = (size_t)(out - output->buffer);
+
+    return status;
+}
+
+struct aws_huffman_symbol_coder *test_long_codes_get_coder(void) {
+
+    static struct aws_huffman_symbol_coder coder = {
+        .encode = encode_symbol,
+        .decode = decode_symbol,
+        .decode_buffer = decode_buffer,
+        .userdata = NULL,
+        .code_lengths = code_lengths,
+        .min_code_length = 1,
+        .max_code_length = 32,
+        .packed_codes = packed_codes,
+    };
+    return &coder;
+}
+
+AWS_HUFFMAN_DEFINE_STATIC_CODER(test_long_codes, packed_codes, decode_buffer)
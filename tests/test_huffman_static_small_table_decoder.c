@@ -0,0 +1,529 @@
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/* WARNING: THIS FILE WAS AUTOMATICALLY GENERATED. DO NOT EDIT. */
+/* clang-format off */
+
+#include <aws/compression/error.h>
+#include <aws/compression/huffman.h>
+#include <aws/compression/huffman_static_coder.h>
+
+#include <aws/common/byte_order.h>
+#include <aws/common/error.h>
+
+#include <string.h>
+
+static const uint32_t packed_codes[] = {
+    0x72e, /* ' ' 0 */
+    0x72f, /* ' ' 1 */
+    0x730, /* ' ' 2 */
+    0x731, /* ' ' 3 */
+    0x732, /* ' ' 4 */
+    0x733, /* ' ' 5 */
+    0x734, /* ' ' 6 */
+    0x735, /* ' ' 7 */
+    0x736, /* ' ' 8 */
+    0x737, /* ' ' 9 */
+    0x1b8, /* ' ' 10 */
+    0x738, /* ' ' 11 */
+    0x739, /* ' ' 12 */
+    0x73a, /* ' ' 13 */
+    0x73b, /* ' ' 14 */
+    0x73c, /* ' ' 15 */
+    0x73d, /* ' ' 16 */
+    0x73e, /* ' ' 17 */
+    0x73f, /* ' ' 18 */
+    0x740, /* ' ' 19 */
+    0x741, /* ' ' 20 */
+    0x742, /* ' ' 21 */
+    0x743, /* ' ' 22 */
+    0x744, /* ' ' 23 */
+    0x745, /* ' ' 24 */
+    0x746, /* ' ' 25 */
+    0x747, /* ' ' 26 */
+    0x748, /* ' ' 27 */
+    0x749, /* ' ' 28 */
+    0x74a, /* ' ' 29 */
+    0x74b, /* ' ' 30 */
+    0x74c, /* ' ' 31 */
+    0x24, /* ' ' 32 */
+    0x74d, /* '!' 33 */
+    0x74e, /* '"' 34 */
+    0x74f, /* '#' 35 */
+    0x750, /* '$' 36 */
+    0x751, /* '%' 37 */
+    0x752, /* '&' 38 */
+    0xd6, /* ''' 39 */
+    0x753, /* '(' 40 */
+    0x754, /* ')' 41 */
+    0x755, /* '*' 42 */
+    0x756, /* '+' 43 */
+    0x1b9, /* ',' 44 */
+    0x388, /* '-' 45 */
+    0xd7, /* '.' 46 */
+    0x757, /* '/' 47 */
+    0x758, /* '0' 48 */
+    0x759, /* '1' 49 */
+    0x75a, /* '2' 50 */
+    0x75b, /* '3' 51 */
+    0x75c, /* '4' 52 */
+    0x75d, /* '5' 53 */
+    0x75e, /* '6' 54 */
+    0x75f, /* '7' 55 */
+    0x760, /* '8' 56 */
+    0x761, /* '9' 57 */
+    0x762, /* ':' 58 */
+    0x763, /* ';' 59 */
+    0x764, /* '<' 60 */
+    0x765, /* '=' 61 */
+    0x766, /* '>' 62 */
+    0x1ba, /* '?' 63 */
+    0x767, /* '@' 64 */
+    0x768, /* 'A' 65 */
+    0x1bb, /* 'B' 66 */
+    0x389, /* 'C' 67 */
+    0x38a, /* 'D' 68 */
+    0x38b, /* 'E' 69 */
+    0x38c, /* 'F' 70 */
+    0x38d, /* 'G' 71 */
+    0x38e, /* 'H' 72 */
+    0x1bc, /* 'I' 73 */
+    0x769, /* 'J' 74 */
+    0x76a, /* 'K' 75 */
+    0x38f, /* 'L' 76 */
+    0x390, /* 'M' 77 */
+    0x76b, /* 'N' 78 */
+    0x76c, /* 'O' 79 */
+    0x391, /* 'P' 80 */
+    0x76d, /* 'Q' 81 */
+    0x76e, /* 'R' 82 */
+    0x76f, /* 'S' 83 */
+    0x1bd, /* 'T' 84 */
+    0x770, /* 'U' 85 */
+    0x392, /* 'V' 86 */
+    0x1be, /* 'W' 87 */
+    0x771, /* 'X' 88 */
+    0x393, /* 'Y' 89 */
+    0x772, /* 'Z' 90 */
+    0x773, /* '[' 91 */
+    0x774, /* '\' 92 */
+    0x775, /* ']' 93 */
+    0x776, /* '^' 94 */
+    0x777, /* '_' 95 */
+    0x778, /* '`' 96 */
+    0x25, /* 'a' 97 */
+    0xd8, /* 'b' 98 */
+    0x60, /* 'c' 99 */
+    0x61, /* 'd' 100 */
+    0x26, /* 'e' 101 */
+    0x62, /* 'f' 102 */
+    0xd9, /* 'g' 103 */
+    0x63, /* 'h' 104 */
+    0x27, /* 'i' 105 */
+    0x1bf, /* 'j' 106 */
+    0x64, /* 'k' 107 */
+    0x65, /* 'l' 108 */
+    0x66, /* 'm' 109 */
+    0x28, /* 'n' 110 */
+    0x29, /* 'o' 111 */
+    0xda, /* 'p' 112 */
+    0x394, /* 'q' 113 */
+    0x2a, /* 'r' 114 */
+    0x2b, /* 's' 115 */
+    0x2c, /* 't' 116 */
+    0x2d, /* 'u' 117 */
+    0x1c0, /* 'v' 118 */
+    0x67, /* 'w' 119 */
+    0x1c1, /* 'x' 120 */
+    0x68, /* 'y' 121 */
+    0x779, /* 'z' 122 */
+    0x77a, /* '{' 123 */
+    0x77b, /* '|' 124 */
+    0x77c, /* '}' 125 */
+    0x77d, /* '~' 126 */
+    0x77e, /* ' ' 127 */
+    0x77f, /* ' ' 128 */
+    0x780, /* ' ' 129 */
+    0x781, /* ' ' 130 */
+    0x782, /* ' ' 131 */
+    0x783, /* ' ' 132 */
+    0x784, /* ' ' 133 */
+    0x785, /* ' ' 134 */
+    0x786, /* ' ' 135 */
+    0x787, /* ' ' 136 */
+    0x788, /* ' ' 137 */
+    0x789, /* ' ' 138 */
+    0x78a, /* ' ' 139 */
+    0x78b, /* ' ' 140 */
+    0x78c, /* ' ' 141 */
+    0x78d, /* ' ' 142 */
+    0x78e, /* ' ' 143 */
+    0x78f, /* ' ' 144 */
+    0x790, /* ' ' 145 */
+    0x791, /* ' ' 146 */
+    0x792, /* ' ' 147 */
+    0x793, /* ' ' 148 */
+    0x794, /* ' ' 149 */
+    0x795, /* ' ' 150 */
+    0x796, /* ' ' 151 */
+    0x797, /* ' ' 152 */
+    0x798, /* ' ' 153 */
+    0x799, /* ' ' 154 */
+    0x79a, /* ' ' 155 */
+    0x79b, /* ' ' 156 */
+    0x79c, /* ' ' 157 */
+    0x79d, /* ' ' 158 */
+    0x79e, /* ' ' 159 */
+    0x79f, /* ' ' 160 */
+    0x7a0, /* ' ' 161 */
+    0x7a1, /* ' ' 162 */
+    0x7a2, /* ' ' 163 */
+    0x7a3, /* ' ' 164 */
+    0x7a4, /* ' ' 165 */
+    0x7a5, /* ' ' 166 */
+    0x7a6, /* ' ' 167 */
+    0x7a7, /* ' ' 168 */
+    0x7a8, /* ' ' 169 */
+    0x7a9, /* ' ' 170 */
+    0x7aa, /* ' ' 171 */
+    0x7ab, /* ' ' 172 */
+    0x7ac, /* ' ' 173 */
+    0x7ad, /* ' ' 174 */
+    0x7ae, /* ' ' 175 */
+    0x7af, /* ' ' 176 */
+    0x7b0, /* ' ' 177 */
+    0x7b1, /* ' ' 178 */
+    0x7b2, /* ' ' 179 */
+    0x7b3, /* ' ' 180 */
+    0x7b4, /* ' ' 181 */
+    0x7b5, /* ' ' 182 */
+    0x7b6, /* ' ' 183 */
+    0x7b7, /* ' ' 184 */
+    0x7b8, /* ' ' 185 */
+    0x7b9, /* ' ' 186 */
+    0x7ba, /* ' ' 187 */
+    0x7bb, /* ' ' 188 */
+    0x7bc, /* ' ' 189 */
+    0x7bd, /* ' ' 190 */
+    0x7be, /* ' ' 191 */
+    0x7bf, /* ' ' 192 */
+    0x7c0, /* ' ' 193 */
+    0x7c1, /* ' ' 194 */
+    0x7c2, /* ' ' 195 */
+    0x7c3, /* ' ' 196 */
+    0x7c4, /* ' ' 197 */
+    0x7c5, /* ' ' 198 */
+    0x7c6, /* ' ' 199 */
+    0x7c7, /* ' ' 200 */
+    0x7c8, /* ' ' 201 */
+    0x7c9, /* ' ' 202 */
+    0x7ca, /* ' ' 203 */
+    0x7cb, /* ' ' 204 */
+    0x7cc, /* ' ' 205 */
+    0x7cd, /* ' ' 206 */
+    0x7ce, /* ' ' 207 */
+    0x7cf, /* ' ' 208 */
+    0x7d0, /* ' ' 209 */
+    0x7d1, /* ' ' 210 */
+    0x7d2, /* ' ' 211 */
+    0x7d3, /* ' ' 212 */
+    0x7d4, /* ' ' 213 */
+    0x7d5, /* ' ' 214 */
+    0x7d6, /* ' ' 215 */
+    0x7d7, /* ' ' 216 */
+    0x7d8, /* ' ' 217 */
+    0x7d9, /* ' ' 218 */
+    0x7da, /* ' ' 219 */
+    0x7db, /* ' ' 220 */
+    0x7dc, /* ' ' 221 */
+    0x7dd, /* ' ' 222 */
+    0x7de, /* ' ' 223 */
+    0x7df, /* ' ' 224 */
+    0x7e0, /* ' ' 225 */
+    0x7e1, /* ' ' 226 */
+    0x7e2, /* ' ' 227 */
+    0x7e3, /* ' ' 228 */
+    0x7e4, /* ' ' 229 */
+    0x7e5, /* ' ' 230 */
+    0x7e6, /* ' ' 231 */
+    0x7e7, /* ' ' 232 */
+    0x7e8, /* ' ' 233 */
+    0x7e9, /* ' ' 234 */
+    0x7ea, /* ' ' 235 */
+    0x7eb, /* ' ' 236 */
+    0x7ec, /* ' ' 237 */
+    0x7ed, /* ' ' 238 */
+    0x7ee, /* ' ' 239 */
+    0x7ef, /* ' ' 240 */
+    0x7f0, /* ' ' 241 */
+    0x7f1, /* ' ' 242 */
+    0x7f2, /* ' ' 243 */
+    0x7f3, /* ' ' 244 */
+    0x7f4, /* ' ' 245 */
+    0x7f5, /* ' ' 246 */
+    0x7f6, /* ' ' 247 */
+    0x7f7, /* ' ' 248 */
+    0x7f8, /* ' ' 249 */
+    0x7f9, /* ' ' 250 */
+    0x7fa, /* ' ' 251 */
+    0x7fb, /* ' ' 252 */
+    0x7fc, /* ' ' 253 */
+    0x7fd, /* ' ' 254 */
+    0x7fe, /* ' ' 255 */
+};
+
+static const uint8_t code_lengths[] = {
+    10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 8, 10, 10, 10, 10, 10,
+    10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10,
+    5, 10, 10, 10, 10, 10, 10, 7, 10, 10, 10, 10, 8, 9, 7, 10,
+    10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 8,
+    10, 10, 8, 9, 9, 9, 9, 9, 9, 8, 10, 10, 9, 9, 10, 10,
+    9, 10, 10, 10, 8, 10, 9, 8, 10, 9, 10, 10, 10, 10, 10, 10,
+    10, 5, 7, 6, 6, 5, 6, 7, 6, 5, 8, 6, 6, 6, 5, 5,
+    7, 9, 5, 5, 5, 5, 8, 6, 8, 6, 10, 10, 10, 10, 10, 10,
+    10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10,
+    10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10,
+    10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10,
+    10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10,
+    10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10,
+    10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10,
+    10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10,
+    10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10,
+};
+
+static struct aws_huffman_code encode_symbol(uint8_t symbol, void *userdata) {
+    (void)userdata;
+
+    struct aws_huffman_code code_point = {0};
+    const uint32_t packed = packed_codes[symbol];
+    if (packed) {
+        code_point.num_bits = AWS_HUFFMAN_PACKED_NUM_BITS(packed);
+        code_point.pattern = AWS_HUFFMAN_PACKED_PATTERN(packed, code_point.num_bits);
+    }
+    return code_point;
+}
+
+struct decode_table_entry {
+    uint16_t value;
+    uint8_t num_bits;
+    uint8_t sub_bits;
+};
+
+/* { value, num_bits, sub_bits }: 314 entries, 1256 bytes */
+static const struct decode_table_entry decode_table[] = {
+    { 0, 0, 0 }, { 0, 0, 0 }, { 0, 0, 0 }, { 0, 0, 0 }, { 0, 0, 0 }, { 0, 0, 0 }, { 0, 0, 0 }, { 0, 0, 0 },
+    { 32, 5, 0 }, { 32, 5, 0 }, { 97, 5, 0 }, { 97, 5, 0 }, { 101, 5, 0 }, { 101, 5, 0 }, { 105, 5, 0 }, { 105, 5, 0 },
+    { 110, 5, 0 }, { 110, 5, 0 }, { 111, 5, 0 }, { 111, 5, 0 }, { 114, 5, 0 }, { 114, 5, 0 }, { 115, 5, 0 }, { 115, 5, 0 },
+    { 116, 5, 0 }, { 116, 5, 0 }, { 117, 5, 0 }, { 117, 5, 0 }, { 0, 0, 0 }, { 0, 0, 0 }, { 0, 0, 0 }, { 0, 0, 0 },
+    { 99, 6, 0 }, { 100, 6, 0 }, { 102, 6, 0 }, { 104, 6, 0 }, { 107, 6, 0 }, { 108, 6, 0 }, { 109, 6, 0 }, { 119, 6, 0 },
+    { 121, 6, 0 }, { 0, 0, 0 }, { 0, 0, 0 }, { 64, 0, 1 }, { 66, 0, 1 }, { 68, 0, 1 }, { 70, 0, 2 }, { 74, 0, 2 },
+    { 78, 0, 2 }, { 82, 0, 3 }, { 90, 0, 4 }, { 106, 0, 4 }, { 122, 0, 4 }, { 138, 0, 4 }, { 154, 0, 4 }, { 170, 0, 4 },
+    { 186, 0, 4 }, { 202, 0, 4 }, { 218, 0, 4 }, { 234, 0, 4 }, { 250, 0, 4 }, { 266, 0, 4 }, { 282, 0, 4 }, { 298, 0, 4 },
+    { 39, 7, 0 }, { 46, 7, 0 }, { 98, 7, 0 }, { 103, 7, 0 }, { 112, 7, 0 }, { 0, 0, 0 }, { 10, 8, 0 }, { 44, 8, 0 },
+    { 63, 8, 0 }, { 66, 8, 0 }, { 73, 8, 0 }, { 84, 8, 0 }, { 87, 8, 0 }, { 106, 8, 0 }, { 118, 8, 0 }, { 120, 8, 0 },
+    { 0, 0, 0 }, { 0, 0, 0 }, { 45, 9, 0 }, { 67, 9, 0 }, { 68, 9, 0 }, { 69, 9, 0 }, { 70, 9, 0 }, { 71, 9, 0 },
+    { 72, 9, 0 }, { 76, 9, 0 }, { 77, 9, 0 }, { 77, 9, 0 }, { 80, 9, 0 }, { 80, 9, 0 }, { 86, 9, 0 }, { 86, 9, 0 },
+    { 89, 9, 0 }, { 89, 9, 0 }, { 113, 9, 0 }, { 113, 9, 0 }, { 0, 0, 0 }, { 0, 0, 0 }, { 0, 0, 0 }, { 0, 0, 0 },
+    { 0, 10, 0 }, { 1, 10, 0 }, { 2, 10, 0 }, { 3, 10, 0 }, { 4, 10, 0 }, { 5, 10, 0 }, { 6, 10, 0 }, { 7, 10, 0 },
+    { 8, 10, 0 }, { 9, 10, 0 }, { 11, 10, 0 }, { 12, 10, 0 }, { 13, 10, 0 }, { 14, 10, 0 }, { 15, 10, 0 }, { 16, 10, 0 },
+    { 17, 10, 0 }, { 18, 10, 0 }, { 19, 10, 0 }, { 20, 10, 0 }, { 21, 10, 0 }, { 22, 10, 0 }, { 23, 10, 0 }, { 24, 10, 0 },
+    { 25, 10, 0 }, { 26, 10, 0 }, { 27, 10, 0 }, { 28, 10, 0 }, { 29, 10, 0 }, { 30, 10, 0 }, { 31, 10, 0 }, { 33, 10, 0 },
+    { 34, 10, 0 }, { 35, 10, 0 }, { 36, 10, 0 }, { 37, 10, 0 }, { 38, 10, 0 }, { 40, 10, 0 }, { 41, 10, 0 }, { 42, 10, 0 },
+    { 43, 10, 0 }, { 47, 10, 0 }, { 48, 10, 0 }, { 49, 10, 0 }, { 50, 10, 0 }, { 51, 10, 0 }, { 52, 10, 0 }, { 53, 10, 0 },
+    { 54, 10, 0 }, { 55, 10, 0 }, { 56, 10, 0 }, { 57, 10, 0 }, { 58, 10, 0 }, { 59, 10, 0 }, { 60, 10, 0 }, { 61, 10, 0 },
+    { 62, 10, 0 }, { 64, 10, 0 }, { 65, 10, 0 }, { 74, 10, 0 }, { 75, 10, 0 }, { 78, 10, 0 }, { 79, 10, 0 }, { 81, 10, 0 },
+    { 82, 10, 0 }, { 83, 10, 0 }, { 85, 10, 0 }, { 88, 10, 0 }, { 90, 10, 0 }, { 91, 10, 0 }, { 92, 10, 0 }, { 93, 10, 0 },
+    { 94, 10, 0 }, { 95, 10, 0 }, { 96, 10, 0 }, { 122, 10, 0 }, { 123, 10, 0 }, { 124, 10, 0 }, { 125, 10, 0 }, { 126, 10, 0 },
+    { 127, 10, 0 }, { 128, 10, 0 }, { 129, 10, 0 }, { 130, 10, 0 }, { 131, 10, 0 }, { 132, 10, 0 }, { 133, 10, 0 }, { 134, 10, 0 },
+    { 135, 10, 0 }, { 136, 10, 0 }, { 137, 10, 0 }, { 138, 10, 0 }, { 139, 10, 0 }, { 140, 10, 0 }, { 141, 10, 0 }, { 142, 10, 0 },
+    { 143, 10, 0 }, { 144, 10, 0 }, { 145, 10, 0 }, { 146, 10, 0 }, { 147, 10, 0 }, { 148, 10, 0 }, { 149, 10, 0 }, { 150, 10, 0 },
+    { 151, 10, 0 }, { 152, 10, 0 }, { 153, 10, 0 }, { 154, 10, 0 }, { 155, 10, 0 }, { 156, 10, 0 }, { 157, 10, 0 }, { 158, 10, 0 },
+    { 159, 10, 0 }, { 160, 10, 0 }, { 161, 10, 0 }, { 162, 10, 0 }, { 163, 10, 0 }, { 164, 10, 0 }, { 165, 10, 0 }, { 166, 10, 0 },
+    { 167, 10, 0 }, { 168, 10, 0 }, { 169, 10, 0 }, { 170, 10, 0 }, { 171, 10, 0 }, { 172, 10, 0 }, { 173, 10, 0 }, { 174, 10, 0 },
+    { 175, 10, 0 }, { 176, 10, 0 }, { 177, 10, 0 }, { 178, 10, 0 }, { 179, 10, 0 }, { 180, 10, 0 }, { 181, 10, 0 }, { 182, 10, 0 },
+    { 183, 10, 0 }, { 184, 10, 0 }, { 185, 10, 0 }, { 186, 10, 0 }, { 187, 10, 0 }, { 188, 10, 0 }, { 189, 10, 0 }, { 190, 10, 0 },
+    { 191, 10, 0 }, { 192, 10, 0 }, { 193, 10, 0 }, { 194, 10, 0 }, { 195, 10, 0 }, { 196, 10, 0 }, { 197, 10, 0 }, { 198, 10, 0 },
+    { 199, 10, 0 }, { 200, 10, 0 }, { 201, 10, 0 }, { 202, 10, 0 }, { 203, 10, 0 }, { 204, 10, 0 }, { 205, 10, 0 }, { 206, 10, 0 },
+    { 207, 10, 0 }, { 208, 10, 0 }, { 209, 10, 0 }, { 210, 10, 0 }, { 211, 10, 0 }, { 212, 10, 0 }, { 213, 10, 0 }, { 214, 10, 0 },
+    { 215, 10, 0 }, { 216, 10, 0 }, { 217, 10, 0 }, { 218, 10, 0 }, { 219, 10, 0 }, { 220, 10, 0 }, { 221, 10, 0 }, { 222, 10, 0 },
+    { 223, 10, 0 }, { 224, 10, 0 }, { 225, 10, 0 }, { 226, 10, 0 }, { 227, 10, 0 }, { 228, 10, 0 }, { 229, 10, 0 }, { 230, 10, 0 },
+    { 231, 10, 0 }, { 232, 10, 0 }, { 233, 10, 0 }, { 234, 10, 0 }, { 235, 10, 0 }, { 236, 10, 0 }, { 237, 10, 0 }, { 238, 10, 0 },
+    { 239, 10, 0 }, { 240, 10, 0 }, { 241, 10, 0 }, { 242, 10, 0 }, { 243, 10, 0 }, { 244, 10, 0 }, { 245, 10, 0 }, { 246, 10, 0 },
+    { 247, 10, 0 }, { 248, 10, 0 }, { 249, 10, 0 }, { 250, 10, 0 }, { 251, 10, 0 }, { 252, 10, 0 }, { 253, 10, 0 }, { 254, 10, 0 },
+    { 255, 10, 0 }, { 0, 0, 0 },
+};
+
+static uint8_t decode_symbol(uint32_t bits, uint8_t *symbol, void *userdata) {
+    (void)userdata;
+
+    const struct decode_table_entry *entry = &decode_table[bits >> 26];
+    uint8_t bits_used = 6;
+    while (entry->sub_bits) {
+        const uint32_t index = (bits << bits_used) >> (32 - entry->sub_bits);
+        bits_used += entry->sub_bits;
+        entry = &decode_table[entry->value + index];
+    }
+
+    if (entry->num_bits) {
+        *symbol = (uint8_t)entry->value;
+    }
+    return entry->num_bits;
+}
+
+struct multi_decode_table_entry {
+    uint8_t num_bits;
+    uint8_t num_symbols;
+    uint8_t symbols[1];
+};
+
+/* { num_bits, num_symbols, { symbols } }: 64 entries, 192 bytes */
+static const struct multi_decode_table_entry multi_decode_table[] = {
+    { 0, 0, { 0 } }, { 0, 0, { 0 } }, { 0, 0, { 0 } }, { 0, 0, { 0 } },
+    { 0, 0, { 0 } }, { 0, 0, { 0 } }, { 0, 0, { 0 } }, { 0, 0, { 0 } },
+    { 5, 1, { 32 } }, { 5, 1, { 32 } }, { 5, 1, { 97 } }, { 5, 1, { 97 } },
+    { 5, 1, { 101 } }, { 5, 1, { 101 } }, { 5, 1, { 105 } }, { 5, 1, { 105 } },
+    { 5, 1, { 110 } }, { 5, 1, { 110 } }, { 5, 1, { 111 } }, { 5, 1, { 111 } },
+    { 5, 1, { 114 } }, { 5, 1, { 114 } }, { 5, 1, { 115 } }, { 5, 1, { 115 } },
+    { 5, 1, { 116 } }, { 5, 1, { 116 } }, { 5, 1, { 117 } }, { 5, 1, { 117 } },
+    { 0, 0, { 0 } }, { 0, 0, { 0 } }, { 0, 0, { 0 } }, { 0, 0, { 0 } },
+    { 6, 1, { 99 } }, { 6, 1, { 100 } }, { 6, 1, { 102 } }, { 6, 1, { 104 } },
+    { 6, 1, { 107 } }, { 6, 1, { 108 } }, { 6, 1, { 109 } }, { 6, 1, { 119 } },
+    { 6, 1, { 121 } }, { 0, 0, { 0 } }, { 0, 0, { 0 } }, { 0, 0, { 0 } },
+    { 0, 0, { 0 } }, { 0, 0, { 0 } }, { 0, 0, { 0 } }, { 0, 0, { 0 } },
+    { 0, 0, { 0 } }, { 0, 0, { 0 } }, { 0, 0, { 0 } }, { 0, 0, { 0 } },
+    { 0, 0, { 0 } }, { 0, 0, { 0 } }, { 0, 0, { 0 } }, { 0, 0, { 0 } },
+    { 0, 0, { 0 } }, { 0, 0, { 0 } }, { 0, 0, { 0 } }, { 0, 0, { 0 } },
+    { 0, 0, { 0 } }, { 0, 0, { 0 } }, { 0, 0, { 0 } }, { 0, 0, { 0 } },
+};
+
+static uint8_t decode_symbols(uint32_t bits, uint8_t *symbols, uint8_t *num_symbols, void *userdata) {
+
+    const struct multi_decode_table_entry *entry = &multi_decode_table[bits >> 26];
+    if (entry->num_symbols == 0) {
+        /* The window doesn't contain a whole code */
+        *num_symbols = 1;
+        return decode_symbol(bits, symbols, userdata);
+    }
+
+    memcpy(symbols, entry->symbols, sizeof(entry->symbols));
+    *num_symbols = entry->num_symbols;
+    return entry->num_bits;
+}
+
+static enum aws_huffman_status decode_buffer(
+    struct aws_huffman_decoder *decoder,
+    struct aws_byte_cursor *to_decode,
+    struct aws_byte_buf *output,
+    void *userdata) {
+    (void)userdata;
+
+    uint64_t working_bits = decoder->working_bits;
+    uint8_t num_bits = decoder->num_bits;
+    const uint8_t *input = to_decode->ptr;
+    const uint8_t *input_end = to_decode->ptr + to_decode->len;
+    uint8_t *out = output->buffer + output->len;
+    uint8_t *out_end = output->buffer + output->capacity;
+
+    enum aws_huffman_status status = AWS_HUFFMAN_NEED_INPUT;
+    while (1) {
+        if (num_bits < 10) {
+            if (input_end - input >= (ptrdiff_t)sizeof(uint64_t)) {
+                /* Top up with a single unaligned big-endian load, keeping as many whole bytes as fit */
+                const uint8_t num_bytes = (63 - num_bits) / 8;
+                uint64_t new_bits = 0;
+                memcpy(&new_bits, input, sizeof(new_bits));
+                new_bits = aws_ntoh64(new_bits) & (UINT64_MAX << (64 - num_bytes * 8));
+
+                working_bits |= new_bits >> num_bits;
+                num_bits += num_bytes * 8;
+                input += num_bytes;
+            } else {
+                while (num_bits <= 56 && input != input_end) {
+                    working_bits |= (uint64_t)*input++ << (56 - num_bits);
+                    num_bits += 8;
+                }
+            }
+        }
+
+        if (num_bits == 0) {
+            /* Successfully decoded whole buffer */
+            break;
+        }
+
+        const uint32_t bits = (uint32_t)(working_bits >> 32);
+
+        const struct multi_decode_table_entry *multi_entry = &multi_decode_table[bits >> 26];
+        if (multi_entry->num_symbols && multi_entry->num_bits <= num_bits &&
+            (size_t)(out_end - out) >= sizeof(multi_entry->symbols)) {
+
+            memcpy(out, multi_entry->symbols, sizeof(multi_entry->symbols));
+            out += multi_entry->num_symbols;
+            working_bits <<= multi_entry->num_bits;
+            num_bits -= multi_entry->num_bits;
+            continue;
+        }
+
+        uint8_t symbol = 0;
+        const uint8_t bits_read = decode_symbol(bits, &symbol, NULL);
+
+        if (bits_read == 0) {
+            if (input == input_end && num_bits < 10) {
+                /* More input is needed to continue */
+                break;
+            }
+            /* Unknown symbol found */
+            aws_raise_error(AWS_ERROR_COMPRESSION_UNKNOWN_SYMBOL);
+            status = AWS_HUFFMAN_ERROR;
+            break;
+        }
+        if (bits_read > num_bits) {
+            /* The rest of the input is part of a symbol that isn't complete yet */
+            break;
+        }
+        if (out == out_end) {
+            status = AWS_HUFFMAN_NEED_OUTPUT;
+            break;
+        }
+
+        working_bits <<= bits_read;
+        num_bits -= bits_read;
+        *out++ = symbol;
+    }
+
+    decoder->working_bits = working_bits;
+    decoder->num_bits = num_bits;
+    aws_byte_cursor_advance(to_decode, (size_t)(input - to_decode->ptr));
+    output->len = (size_t)(out - output->buffer);
+
+    return status;
+}
+
+struct aws_huffman_symbol_coder *test_small_table_get_coder(void) {
+
+    static struct aws_huffman_symbol_coder coder = {
+        .encode = encode_symbol,
+        .decode = decode_symbol,
+        .decode_multi = decode_symbols,
+        .decode_buffer = decode_buffer,
+        .userdata = NULL,
+        .code_lengths = code_lengths,
+        .min_code_length = 5,
+        .max_code_length = 10,
+        .packed_codes = packed_codes,
+    };
+    return &coder;
+}
+
+AWS_HUFFMAN_DEFINE_STATIC_CODER(test_small_table, packed_codes, decode_buffer)